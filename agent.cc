@@ -1,23 +1,12 @@
 #include "agent.h"
 
-bool Agent::isCheckmated(Board& board, ColorType color) {
-	std::vector<Move> possibleMoves = board.getAllValidColorMoves(color, false);
-
-	// Checkmate is when a color that is in check also has no valid moves
-	if (board.isColorInCheck(color) && (possibleMoves.size() == 0)) {
-		return true;
-	} else {
-		return false;
-	}
-}
-
 Player::Player() {
 	aType = AgentType::PLAYER;
 }
 
 // This method is never used but it must be defined anywas
-Move Player::getMove(Board& board, ColorType color) {
-	return Move(MoveType::NONE, board.getAt(0,0), board.getAt(0,0), board.getAt(0,0));
+Move Player::getMove(Board& board, ColorType color, MoveList &legalMoves) {
+	return Move(MoveType::NONE, board, std::pair<int, int>(0, 0), std::pair<int, int>(0, 0), std::pair<int, int>(0, 0));
 }
 
 Bot::Bot(int level) {
@@ -37,10 +26,18 @@ int Bot::getRandomInt(int lowerBound, int upperBound) {
 	return value;
 }
 
-Move Bot::getMove(Board& board, ColorType color) {
-	// Get all moves that this bot could play
-	std::vector<Move> possibleMoves = board.getAllValidColorMoves(color, false);
+// The highest getPiecePoints() value among the pieces of color standing on the tiles in enemyAttacks
+static int highestValueAttacked(Board &board, ColorType color, Bitboard enemyAttacks) {
+	int highestValue = 0;
+	for (int pt = (int)PieceType::PAWN; pt <= (int)PieceType::KING; pt++) {
+		if (board.getPieces(color, (PieceType)pt) & enemyAttacks) {
+			highestValue = std::max(highestValue, getPiecePoints((PieceType)pt));
+		}
+	}
+	return highestValue;
+}
 
+Move Bot::getMove(Board& board, ColorType color, MoveList &possibleMoves) {
 	// Create move with rankings
 	std::vector<std::pair<int, Move>> moveScores;
 
@@ -72,18 +69,14 @@ Move Bot::getMove(Board& board, ColorType color) {
 
 	} else if (level() == 3) {
 		
-		// Get enemy moves
+		// The tiles the enemy attacks
 		ColorType enemyColor = oppositeColor(color);
-		std::vector<Move> enemyMoves = board.getAllValidColorMoves(enemyColor);
+		Bitboard attacks[2];
+		board.getAttackMaps(attacks);
+		Bitboard enemyAttacks = attacks[(int)enemyColor];
 
 		// Determine highest value attack, avoid that capture if doesn't have equivalent value capture
-		int highestValueUnderAttack = 0;
-		for (Move &mv : enemyMoves) {
-			int attackedValue = getPiecePoints(mv.getCapturePieceType());
-			if (attackedValue > highestValueUnderAttack) {
-				highestValueUnderAttack = attackedValue;
-			}
-		}
+		int highestValueUnderAttack = highestValueAttacked(board, color, enemyAttacks);
 
 		// Loop through bot's possible moves
 		for (Move &mv : possibleMoves) {
@@ -102,11 +95,8 @@ Move Bot::getMove(Board& board, ColorType color) {
 			// If this position is attacked by enemies, remove score (avoiding capture)
 			// This is avoiding capture
 			int thisPieceValue = getPiecePoints(mv.getFromPieceType());
-			for (Move &enemyMv : enemyMoves) {
-				if (enemyMv.getCapturePosition() == mv.getCapturePosition()) {
-					curScore -= 1 * thisPieceValue;
-					break;
-				}
+			if (enemyAttacks & squareBB(mv.getCaptureSquare())) {
+				curScore -= 1 * thisPieceValue;
 			}
 
 			// Perfer moves near the center
@@ -136,7 +126,9 @@ Move Bot::getMove(Board& board, ColorType color) {
 
 	} else if (level() == 4) {
 		ColorType enemyColor = oppositeColor(color);
-		std::vector<Move> enemyMoves = board.getAllValidColorMoves(enemyColor);
+		Bitboard attacks[2];
+		board.getAttackMaps(attacks);
+		Bitboard enemyAttacks = attacks[(int)enemyColor];
 
 		// Calculate simple piece score
 		// Pawn: 1
@@ -145,35 +137,17 @@ Move Bot::getMove(Board& board, ColorType color) {
 		// Rook: 5
 		// Queen: 9
 		// King: 0
-		int blackPieceScore = 0;
-		int whitePieceScore = 0;
+		// The board keeps both totals up to date as pieces come and go
+		int blackPieceScore = board.getMaterial(ColorType::BLACK);
+		int whitePieceScore = board.getMaterial(ColorType::WHITE);
 
 		// TODO: preference for trading when having higher piecescore and aversion when having less piecescore
-		for (int row = 0; row < BOARD_Y; row++) {
-			for (int col = 0; col < BOARD_X; col++) {
-				std::shared_ptr<Piece> pn = board.getAt(col, row);
-
-				// Calculate cumulative black and white piece scores
-				if (pn->getColorType() == ColorType::WHITE) {
-					whitePieceScore += getPiecePoints(pn->getPieceType());
-				} else if (pn->getColorType() == ColorType::BLACK) {
-					blackPieceScore += getPiecePoints(pn->getPieceType());
-				}
-				
-			}
-		}
 
 		// Determine if current agent has more or less piece score
 		bool hasMoreScore = color == ColorType::WHITE ? (whitePieceScore > blackPieceScore) : (blackPieceScore > whitePieceScore);
 
 		// Determine highest value attack, avoid that capture if doesn't have equivalent value capture
-		int highestValueUnderAttack = 0;
-		for (Move& mv : enemyMoves) {
-			int attackedValue = getPiecePoints(mv.getCapturePieceType());
-			if (attackedValue > highestValueUnderAttack) {
-				highestValueUnderAttack = attackedValue;
-			}
-		}
+		int highestValueUnderAttack = highestValueAttacked(board, color, enemyAttacks);
 
 		// Loop over possible moves
 		for (Move& mv : possibleMoves) {
@@ -190,11 +164,8 @@ Move Bot::getMove(Board& board, ColorType color) {
 			// If this position is attacked by enemies, remove score (avoiding capture)
 			// This is avoiding capture
 			int thisPieceValue = getPiecePoints(mv.getFromPieceType());
-			for (Move& enemyMv : enemyMoves) {
-				if (enemyMv.getCapturePosition() == mv.getCapturePosition()) {
-					curScore -= 1 * thisPieceValue;
-					break;
-				}
+			if (enemyAttacks & squareBB(mv.getCaptureSquare())) {
+				curScore -= 1 * thisPieceValue;
 			}
 
 			// Add score if promote, add pereferce for higher value promotes
@@ -215,15 +186,13 @@ Move Bot::getMove(Board& board, ColorType color) {
 				board.enactMove(mv);
 
 				// Check if this piece can be recaptured
-				std::vector<Move> possibleRecaptures = board.getAllValidColorMoves(enemyColor);
-
-				for (Move &potentialReplies : possibleRecaptures) {
-					if (potentialReplies.getCapturePosition() == mv.getCapturePosition()) {
-						// Remove more points for higher value recaptures
-						curScore -= getPiecePoints(mv.getFromPieceType()); // It hurts more to loss
-						curScore += getPiecePoints(mv.getCapturePieceType()) / 2; // It gains less to get
-						break;
-					}
+				Bitboard attacksAfter[2];
+				board.getAttackMaps(attacksAfter);
+
+				if (attacksAfter[(int)enemyColor] & squareBB(mv.getCaptureSquare())) {
+					// Remove more points for higher value recaptures
+					curScore -= getPiecePoints(mv.getFromPieceType()); // It hurts more to loss
+					curScore += getPiecePoints(mv.getCapturePieceType()) / 2; // It gains less to get
 				}
 
 				board.undoLastMove();
@@ -281,7 +250,7 @@ Move Bot::getMove(Board& board, ColorType color) {
 	}
 
 	// Get vector of only the highest scoring moves
-	std::vector<Move> highestScoreMoves;
+	MoveList highestScoreMoves;
 	for (std::pair<int, Move> &scoreMovePair : moveScores) {
 		if (scoreMovePair.first == highestScore) {
 			highestScoreMoves.push_back(scoreMovePair.second);
@@ -29,17 +29,15 @@ class Agent {
 		bool isBot() {
 			return aType == AgentType::BOT;
 		}
-		// Determine the move to play
-		virtual Move getMove(Board &board, ColorType color) = 0;
-		// Determine if the current color is in checkmate
-		bool isCheckmated(Board& board, ColorType color);
+		// Determine the move to play out of legalMoves, the legal moves of color that Board::gameState() returned
+		virtual Move getMove(Board &board, ColorType color, MoveList &legalMoves) = 0;
 };
 
 // The player class is essentially used, if I had more time I would move a lot of logic from main.cc to this class
 class Player : public Agent {
 	public:
 		Player();
-		Move getMove(Board& board, ColorType color);
+		Move getMove(Board& board, ColorType color, MoveList &legalMoves);
 };
 
 class Bot : public Agent {
@@ -47,7 +45,7 @@ class Bot : public Agent {
 	int getRandomInt(int lowerBound, int upperBound);
 	public:
 		Bot(int level);
-		Move getMove(Board& board, ColorType color);
+		Move getMove(Board& board, ColorType color, MoveList &possibleMoves);
 };
 
 
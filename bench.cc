@@ -0,0 +1,116 @@
+#include "bench.h"
+
+const BenchPosition BENCH_POSITIONS[] = {
+	{ "rnbqkbnrpppppppp________________________________PPPPPPPPRNBQKBNR", 0 },
+	{ "r___k__rp_ppqpb_bn__pnp____PN____p__P_____N__Q_pPPPBBPPPR___K__R", 0 },
+	{ "__________p________p____KP_____r_R___p_k____________P_P_________", 0 },
+	{ "r___k__rPppp_ppp_b___nbNnP______BBP_P___q____N__Pp_P__PPR__Q_RK_", 0 },
+	{ "rnbq_k_rpp_Pbppp__p_______________B_____________PPP_NnPPRNBQK__R", 0 },
+	{ "r____rk__pp_qpppp_np_n____b_p_B___B_P_b_P_NP_N___PP_QPPPR____RK_", 0 },
+	{ "____rrk_pp_n___p___q__pQ__p_pb____PP______P___N_P__B__PP____RRK_", 1 },
+	{ "rq___rk_ppp__ppp_bnpb______N__B____NP__________PPPPQ_PP___KR___R", 0 },
+	{ "r_bq_r_k_pp_n_pp_p_p________p__Q____Pp___BNP____PPP__PPP___R_RK_", 0 },
+	{ "r___r_k___p__pppp_p_bn___________q__P_____NPQN__PPP___PPR____RK_", 1 },
+	{ "r_bbk_nrpp___p_p__n______N____p___Np_B__________PPP__PPP__KR_B_R", 0 },
+	{ "r_bq_rk_ppp_nppp____n______p___Q___P_____BP_B___PP_N__PPR____RK_", 0 },
+	{ "____r_k_r_q__pppppp__n______P________Rb__N_BQ___PPP___PPR_____K_", 0 },
+	{ "__rqkb_rppp__p____npb_p__N_Nn__p__P_PP__________PP__B_PPR_BQK__R", 1 },
+	{ "r_bq_r_kb_p_npp_p__p___p_p_________PP____B__NN__PP___PPPR__Q_RK_", 0 },
+	{ "___r_rk_p_____ppbpp_pp__________q_PP_P__b___P___P__NQRPP_R__B_K_", 1 },
+	{ "r_q__rk___p_bppp__Pp____p______bQ_PNp_______B___PP_R_PPP__K____R", 0 },
+	{ "____k__r_pb__ppp_p__p____R_p_______P______r_PN__P____PPP_R____K_", 1 },
+	{ "___q__k_pb___p_p____pbp___r_____PpN__N___P__P__P_____PP_Q__R__K_", 1 },
+	{ "______k____b___r_p_p____p_n__p___PPNpP_qP___Q_p__R_RB_P______K__", 1 },
+	{ "r__r_n__pp__bk____p_p__p___q_______PN_QP__P___R_P____PP______RK_", 0 },
+	{ "r_bqkb_rpppp_ppp__n__n______p_____B_P________N__PPPP_PPPRNBQK__R", 0 },
+	{ "rnbqkb_rpp___ppp____pn____pp______PP______N__N__PP__PPPPR_BQKB_R", 0 },
+	{ "r_bqk__rpp__bppp__n_pn_____p______PP______N_PN__PP___PPPR_BQKB_R", 0 },
+	{ "______k_______p_______Ppppp________pn__P_P___K___PP__P_____N____", 1 },
+	{ "___b_________kp__p_p_p_ppP_PpP_PP_P_P______KN___________________", 0 },
+	{ "__K_____p______________P_____pR______________k__r_______________", 0 },
+	{ "______________pk_p______________PP___p_p_____P______KP_q___Q____", 0 },
+	{ "_______k___p__pp____q_______________Q________Kp_P______b________", 0 },
+	{ "__________p_______________kPKp_p__p____P__P________P____________", 0 },
+	{ "_________p___pp________p_____P_P__k___P___________K__P__________", 0 },
+	{ "________pp__r_k___p_p______pP__p_P_P_P_PP_____KR________________", 0 },
+	{ "___________p____p_bk___pPp_______Kp_PpPp__P__P_P__P__________B__", 1 },
+	{ "_____k_________R____P__p_____K__p_r__P_p________________________", 1 },
+	{ "______k_______p_P______pr_N__________p_________P_b___PP_____R_K_", 0 },
+	{ "_r___k______q_____Pp___b___Bp_____Q__p___p_P__P__P__KP_____N____", 0 },
+	{ "______k_____pp_p___p__p_P_pPb___R________r__P_PP___B_P________K_", 0 },
+	{ "___________p___B_____p_______P__p_______PP_____bk_____________K_", 0 },
+	{ "_____________________________N__________p_________________NK___k", 0 },
+	{ "___________k________________________________B_______KB____B_____", 0 },
+	{ "_________________P___________pr_____________R__________k__K_____", 0 },
+	{ "__________p____P________kr____________R__________________K______", 0 },
+};
+
+const int BENCH_POSITION_COUNT = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+
+// FNV-1a over the bytes of each count
+static unsigned long long addToSignature(unsigned long long signature, unsigned long long nodes) {
+	for (int i = 0; i < 8; i++) {
+		signature ^= (nodes >> (8 * i)) & 0xFF;
+		signature *= 0x100000001B3ULL;
+	}
+	return signature;
+}
+
+Board loadBenchPosition(const BenchPosition &position) {
+	char tiles[8][8];
+	for (int row = 0; row < 8; row++) {
+		for (int col = 0; col < 8; col++) {
+			tiles[row][col] = position.tiles[row * 8 + col];
+		}
+	}
+
+	Board board(tiles);
+	board.setTurnNumber(position.turnNumber);
+	return board;
+}
+
+unsigned long long runBench(int depth) {
+	const int positionCount = BENCH_POSITION_COUNT;
+
+	unsigned long long signature = 0xCBF29CE484222325ULL;
+	unsigned long long totalNodes = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < positionCount; i++) {
+		Board board = loadBenchPosition(BENCH_POSITIONS[i]);
+		unsigned long long nodes = perft(board, depth);
+
+		std::cout << "Position " << (i + 1) << "/" << positionCount << ": " << nodes << std::endl;
+		totalNodes += nodes;
+		signature = addToSignature(signature, nodes);
+	}
+	auto end = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(end - start).count();
+
+	// Every level once in every position that is still being played
+	int botMoves = 0;
+	auto botStart = std::chrono::steady_clock::now();
+	for (int level = 1; level <= 4; level++) {
+		Bot bot(level);
+		for (int i = 0; i < positionCount; i++) {
+			Board board = loadBenchPosition(BENCH_POSITIONS[i]);
+			MoveList legalMoves;
+			if (board.gameState(legalMoves) == GameState::ONGOING) {
+				bot.getMove(board, intToColorType(board.getTurnNumber()), legalMoves);
+				botMoves++;
+			}
+		}
+	}
+	auto botEnd = std::chrono::steady_clock::now();
+	double botSeconds = std::chrono::duration<double>(botEnd - botStart).count();
+
+	std::cout << std::endl;
+	std::cout << "Depth: " << depth << std::endl;
+	std::cout << "Nodes: " << totalNodes << std::endl;
+	std::cout << "Time: " << seconds << " s" << std::endl;
+	std::cout << "Nodes/sec: " << (unsigned long long)(totalNodes / seconds) << std::endl;
+	std::cout << "Bot moves: " << botMoves << " in " << botSeconds << " s" << std::endl;
+	std::cout << "Signature: " << std::hex << std::setw(16) << std::setfill('0') << signature << std::dec << std::setfill(' ') << std::endl;
+
+	return signature;
+}
@@ -0,0 +1,37 @@
+#ifndef _HEADER_BENCH_H_
+#define _HEADER_BENCH_H_
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+#include "board.h"
+#include "agent.h"
+#include "perft.h"
+
+class Board;
+
+const int BENCH_DEFAULT_DEPTH = 4;
+
+// A position as its 64 tiles from the top left corner, row by row, in the letters of the setup command
+// with '_' for an empty tile. Kings and rooks on their home tiles may castle
+struct BenchPosition {
+	const char *tiles;
+	int turnNumber;
+};
+
+// The bench positions, also the corpus of the boardbench microbenchmarks
+extern const BenchPosition BENCH_POSITIONS[];
+extern const int BENCH_POSITION_COUNT;
+
+Board loadBenchPosition(const BenchPosition &position);
+
+// Runs perft to depth on a fixed set of positions, openings through endgames, and prints the total nodes,
+// the time, the nodes per second and a signature of every count in order
+// The signature changes only when the moves generated do, two builds with the same signature did the same work
+// so their times can be compared. Each bot level also picks a move in every position, those are timed but
+// left out of the signature because the bots break ties at random
+// Returns the signature
+unsigned long long runBench(int depth = BENCH_DEFAULT_DEPTH);
+
+#endif // !_HEADER_BENCH_H_
@@ -0,0 +1,50 @@
+#include "bitboard.h"
+
+Bitboard pawnAttacks(ColorType ct, Bitboard pawns) {
+	Bitboard forwards = pawnPushes(ct, pawns);
+	return shiftLeft(forwards) | shiftRight(forwards);
+}
+
+Bitboard knightAttacks(Bitboard knights) {
+	Bitboard oneSide = shiftLeft(knights) | shiftRight(knights);
+	Bitboard twoSide = shiftLeft(shiftLeft(knights)) | shiftRight(shiftRight(knights));
+
+	// Jump two rows with one column of side step, or one row with two columns
+	return (oneSide << 16) | (oneSide >> 16) | (twoSide << 8) | (twoSide >> 8);
+}
+
+Bitboard kingAttacks(Bitboard kings) {
+	Bitboard row = kings | shiftLeft(kings) | shiftRight(kings);
+	return (row | shiftUp(row) | shiftDown(row)) & ~kings;
+}
+
+// Walks from square in the direction (stepX, stepY) until it leaves the board or hits a piece
+Bitboard rayAttacks(int square, Bitboard occupied, int stepX, int stepY) {
+	Bitboard attacks = EMPTY_BB;
+
+	int x = squareX(square) + stepX;
+	int y = squareY(square) + stepY;
+	while ((0 <= x) && (x < 8) && (0 <= y) && (y < 8)) {
+		attacks |= squareBB(squareOf(x, y));
+
+		// We hit a piece, sliders cannot go through pieces
+		if (occupied & squareBB(squareOf(x, y))) {
+			break;
+		}
+
+		x += stepX;
+		y += stepY;
+	}
+
+	return attacks;
+}
+
+Bitboard bishopRayAttacks(int square, Bitboard occupied) {
+	return rayAttacks(square, occupied, -1, -1) | rayAttacks(square, occupied, 1, -1) |
+		rayAttacks(square, occupied, -1, 1) | rayAttacks(square, occupied, 1, 1);
+}
+
+Bitboard rookRayAttacks(int square, Bitboard occupied) {
+	return rayAttacks(square, occupied, -1, 0) | rayAttacks(square, occupied, 1, 0) |
+		rayAttacks(square, occupied, 0, -1) | rayAttacks(square, occupied, 0, 1);
+}
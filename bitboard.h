@@ -0,0 +1,131 @@
+#ifndef _HEADER_BITBOARD_H_
+#define _HEADER_BITBOARD_H_
+
+#include "piececode.h"
+
+// A Bitboard has one bit per tile, tile (x, y) is bit y * 8 + x
+// Bit 0 is the top left corner of the board (a8) and bit 63 the bottom right corner (h1)
+typedef unsigned long long Bitboard;
+
+const Bitboard EMPTY_BB = 0ULL;
+const Bitboard FILE_A_BB = 0x0101010101010101ULL;
+const Bitboard FILE_H_BB = FILE_A_BB << 7;
+const Bitboard ROW_0_BB = 0xFFULL;
+
+constexpr Bitboard squareBB(int square) {
+	return 1ULL << square;
+}
+
+constexpr Bitboard rowBB(int row) {
+	return ROW_0_BB << (8 * row);
+}
+
+inline int popCount(Bitboard bb) {
+	return __builtin_popcountll(bb);
+}
+
+// Index of the lowest set bit, bb must not be empty
+inline int lsb(Bitboard bb) {
+	return __builtin_ctzll(bb);
+}
+
+// Removes the lowest set bit and returns its index
+inline int popLsb(Bitboard &bb) {
+	int square = lsb(bb);
+	bb &= bb - 1;
+	return square;
+}
+
+constexpr int squareOf(int x, int y) {
+	return y * 8 + x;
+}
+
+constexpr int squareX(int square) {
+	return square & 7;
+}
+
+constexpr int squareY(int square) {
+	return square >> 3;
+}
+
+// Shifts a whole bitboard one tile, bits falling off the sides of the board are dropped
+// Up is towards row 0 (the black side)
+inline Bitboard shiftUp(Bitboard bb) {
+	return bb >> 8;
+}
+inline Bitboard shiftDown(Bitboard bb) {
+	return bb << 8;
+}
+inline Bitboard shiftLeft(Bitboard bb) {
+	return (bb & ~FILE_A_BB) >> 1;
+}
+inline Bitboard shiftRight(Bitboard bb) {
+	return (bb & ~FILE_H_BB) << 1;
+}
+
+// White pawns move up the board, black pawns move down
+inline Bitboard pawnPushes(ColorType ct, Bitboard pawns) {
+	return (ct == ColorType::WHITE) ? shiftUp(pawns) : shiftDown(pawns);
+}
+template<ColorType Ct>
+inline Bitboard pawnPushes(Bitboard pawns) {
+	return (Ct == ColorType::WHITE) ? shiftUp(pawns) : shiftDown(pawns);
+}
+
+// The tiles attacked by every pawn, knight or king of the bitboard
+Bitboard pawnAttacks(ColorType ct, Bitboard pawns);
+Bitboard knightAttacks(Bitboard knights);
+Bitboard kingAttacks(Bitboard kings);
+
+// Attacks of a single pawn, knight or king indexed by its square
+// The tables are built by constexpr functions so the compiler computes them and they are stored in the binary
+struct AttackTable {
+	Bitboard attacks[64];
+
+	constexpr Bitboard operator[](int square) const {
+		return attacks[square];
+	}
+};
+
+// Every tile reached by one of the (x, y) steps from square, steps that leave the board are dropped
+constexpr Bitboard stepAttacks(int square, const int steps[][2], int stepCount) {
+	Bitboard attacks = EMPTY_BB;
+	for (int i = 0; i < stepCount; i++) {
+		int x = squareX(square) + steps[i][0];
+		int y = squareY(square) + steps[i][1];
+		if ((0 <= x) && (x < 8) && (0 <= y) && (y < 8)) {
+			attacks |= squareBB(squareOf(x, y));
+		}
+	}
+	return attacks;
+}
+
+constexpr AttackTable makeAttackTable(const int steps[][2], int stepCount) {
+	AttackTable table = {};
+	for (int square = 0; square < 64; square++) {
+		table.attacks[square] = stepAttacks(square, steps, stepCount);
+	}
+	return table;
+}
+
+constexpr int KNIGHT_STEPS[8][2] = { {-1, -2}, {1, -2}, {-2, -1}, {2, -1}, {-2, 1}, {2, 1}, {-1, 2}, {1, 2} };
+constexpr int KING_STEPS[8][2] = { {-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1} };
+constexpr int WHITE_PAWN_STEPS[2][2] = { {-1, -1}, {1, -1} };
+constexpr int BLACK_PAWN_STEPS[2][2] = { {-1, 1}, {1, 1} };
+
+constexpr AttackTable KNIGHT_ATTACKS = makeAttackTable(KNIGHT_STEPS, 8);
+constexpr AttackTable KING_ATTACKS = makeAttackTable(KING_STEPS, 8);
+
+// Indexed by the pawn's ColorType first
+constexpr AttackTable PAWN_ATTACKS[2] = { makeAttackTable(WHITE_PAWN_STEPS, 2), makeAttackTable(BLACK_PAWN_STEPS, 2) };
+
+static_assert(KNIGHT_ATTACKS[0] == (squareBB(10) | squareBB(17)), "knight table must be built at compile time");
+static_assert(PAWN_ATTACKS[(int)ColorType::WHITE][squareOf(0, 6)] == squareBB(squareOf(1, 5)), "pawn table must be built at compile time");
+
+// The tiles attacked by a slider on square, blocked by the pieces in occupied
+// The first blocker in each direction is included in the attacks
+// These walk each ray tile by tile, they are used to build the magic tables in magic.h
+Bitboard bishopRayAttacks(int square, Bitboard occupied);
+Bitboard rookRayAttacks(int square, Bitboard occupied);
+
+#endif // !_HEADER_BITBOARD_H_
@@ -1,13 +1,170 @@
 #include "board.h"
 
+// getPiecePoints() by PieceType, kept here so adding a piece does not call into another file
+constexpr int PIECE_POINTS[7] = { 1, 3, 3, 5, 9, 0, 0 };
+
+void Board::resetMaterial() {
+	for (int color = 0; color < 2; color++) {
+		for (int type = 0; type < 6; type++) {
+			pieceCounts[color][type] = 0;
+		}
+		material[color] = 0;
+	}
+	materialKey = 0;
+}
+
+void Board::putPiece(int square, PieceCode pc) {
+	squares[square] = pc;
+
+	Bitboard bb = squareBB(square);
+	pieceBB[(int)colorOf(pc)][(int)pieceTypeOf(pc)] |= bb;
+	colorBB[(int)colorOf(pc)] |= bb;
+	occupiedBB |= bb;
+
+	if (++pieceCounts[(int)colorOf(pc)][(int)pieceTypeOf(pc)] <= MATERIAL_KEY_MAX_COUNT) {
+		materialKey += materialKeyOf(colorOf(pc), pieceTypeOf(pc), 1);
+	}
+	material[(int)colorOf(pc)] += PIECE_POINTS[(int)pieceTypeOf(pc)];
+
+	zobristKey ^= ZOBRIST.pieces[pc][square];
+}
+
+void Board::removePiece(int square) {
+	PieceCode pc = squares[square];
+
+	Bitboard bb = squareBB(square);
+	pieceBB[(int)colorOf(pc)][(int)pieceTypeOf(pc)] ^= bb;
+	colorBB[(int)colorOf(pc)] ^= bb;
+	occupiedBB ^= bb;
+
+	if (pieceCounts[(int)colorOf(pc)][(int)pieceTypeOf(pc)]-- <= MATERIAL_KEY_MAX_COUNT) {
+		materialKey -= materialKeyOf(colorOf(pc), pieceTypeOf(pc), 1);
+	}
+	material[(int)colorOf(pc)] -= PIECE_POINTS[(int)pieceTypeOf(pc)];
+
+	zobristKey ^= ZOBRIST.pieces[pc][square];
+
+	squares[square] = EMPTY_CODE;
+}
+
+void Board::movePiece(int fromSquare, int toSquare) {
+	PieceCode pc = squares[fromSquare];
+
+	Bitboard fromToBB = squareBB(fromSquare) | squareBB(toSquare);
+	pieceBB[(int)colorOf(pc)][(int)pieceTypeOf(pc)] ^= fromToBB;
+	colorBB[(int)colorOf(pc)] ^= fromToBB;
+	occupiedBB ^= fromToBB;
+
+	zobristKey ^= ZOBRIST.pieces[pc][fromSquare] ^ ZOBRIST.pieces[pc][toSquare];
+
+	squares[toSquare] = pc;
+	squares[fromSquare] = EMPTY_CODE;
+}
+
 void Board::loadBoard(char charBoard[8][8]) {
+	for (int color = 0; color < 2; color++) {
+		for (int type = 0; type < 6; type++) {
+			pieceBB[color][type] = EMPTY_BB;
+		}
+		colorBB[color] = EMPTY_BB;
+	}
+	occupiedBB = EMPTY_BB;
+	zobristKey = 0;
+	resetMaterial();
+
 	for (int row = 0; row < BOARD_Y; row++) {
 		for (int col = 0; col < BOARD_X; col++) {
-			internalBoard[row][col] = pieceConstructor(charBoard[row][col], col, row);
+			PieceCode pc = pieceCodeFromChar(charBoard[row][col]);
+
+			squares[row * BOARD_X + col] = EMPTY_CODE;
+			if (pc != EMPTY_CODE) {
+				putPiece(row * BOARD_X + col, pc);
+			}
 		}
 	}
 
-	updateCheckStatus();
+	// A loaded board has no history, so any king and rook still on their home tiles may castle
+	castlingRights = 0;
+	PieceCode whiteRook = makePieceCode(PieceType::ROOK, ColorType::WHITE);
+	PieceCode blackRook = makePieceCode(PieceType::ROOK, ColorType::BLACK);
+	if (squares[squareOf(4, 7)] == makePieceCode(PieceType::KING, ColorType::WHITE)) {
+		castlingRights |= (squares[squareOf(7, 7)] == whiteRook) ? WHITE_KINGSIDE : 0;
+		castlingRights |= (squares[squareOf(0, 7)] == whiteRook) ? WHITE_QUEENSIDE : 0;
+	}
+	if (squares[squareOf(4, 0)] == makePieceCode(PieceType::KING, ColorType::BLACK)) {
+		castlingRights |= (squares[squareOf(7, 0)] == blackRook) ? BLACK_KINGSIDE : 0;
+		castlingRights |= (squares[squareOf(0, 0)] == blackRook) ? BLACK_QUEENSIDE : 0;
+	}
+
+	enPassantSquare = NO_SQUARE;
+	halfmoveClock = 0;
+	zobristKey ^= ZOBRIST.castling[castlingRights];
+
+	moveHistory.clear();
+	undoHistory.clear();
+	moveHistory.reserve(256);
+	undoHistory.reserve(256);
+
+	clearCheckStatus();
+}
+
+BoardSnapshot Board::getSnapshot() {
+	BoardSnapshot snapshot;
+
+	for (int color = 0; color < 2; color++) {
+		snapshot.colorBB[color] = colorBB[color];
+	}
+	for (int type = 0; type < 6; type++) {
+		snapshot.typeBB[type] = pieceBB[0][type] | pieceBB[1][type];
+	}
+
+	snapshot.zobristKey = zobristKey;
+	snapshot.turnNumber = turnNumber;
+	snapshot.halfmoveClock = halfmoveClock;
+	snapshot.castlingRights = castlingRights;
+	snapshot.enPassantSquare = enPassantSquare;
+	snapshot.checkStatus[0] = checkStatus[0];
+	snapshot.checkStatus[1] = checkStatus[1];
+
+	return snapshot;
+}
+
+void Board::loadSnapshot(const BoardSnapshot &snapshot) {
+	for (int square = 0; square < BOARD_SQUARES; square++) {
+		squares[square] = EMPTY_CODE;
+	}
+
+	// Rebuild the mailbox, the bitboards and the material straight from the bitboards, the key is copied as it is
+	resetMaterial();
+	for (int color = 0; color < 2; color++) {
+		colorBB[color] = snapshot.colorBB[color];
+
+		for (int type = 0; type < 6; type++) {
+			pieceBB[color][type] = snapshot.colorBB[color] & snapshot.typeBB[type];
+
+			int count = popCount(pieceBB[color][type]);
+			pieceCounts[color][type] = count;
+			material[color] += count * PIECE_POINTS[type];
+			materialKey += materialKeyOf((ColorType)color, (PieceType)type, std::min(count, MATERIAL_KEY_MAX_COUNT));
+
+			Bitboard pieces = pieceBB[color][type];
+			while (pieces) {
+				squares[popLsb(pieces)] = makePieceCode((PieceType)type, (ColorType)color);
+			}
+		}
+	}
+	occupiedBB = colorBB[0] | colorBB[1];
+
+	zobristKey = snapshot.zobristKey;
+	turnNumber = snapshot.turnNumber;
+	halfmoveClock = snapshot.halfmoveClock;
+	castlingRights = snapshot.castlingRights;
+	enPassantSquare = snapshot.enPassantSquare;
+	checkStatus[0] = snapshot.checkStatus[0];
+	checkStatus[1] = snapshot.checkStatus[1];
+
+	moveHistory.clear();
+	undoHistory.clear();
 }
 
 std::string boolToStr(bool value) {
@@ -19,11 +176,11 @@ std::string boolToStr(bool value) {
 }
 
 void Board::charDraw() {
-	std::cout << "   W: " << boolToStr(isWhiteInCheck) << ", B: " << boolToStr(isBlackInCheck) << ", TURN: " << turnNumber << std::endl;
+	std::cout << "   W: " << boolToStr(isColorInCheck(ColorType::WHITE)) << ", B: " << boolToStr(isColorInCheck(ColorType::BLACK)) << ", TURN: " << turnNumber << std::endl;
 	for (int row = 0; row < BOARD_Y; row++) {
 		std::cout << row << ": ";
 		for (int col = 0; col < BOARD_X; col++) {
-			std::cout << charFromPiece(internalBoard[row][col]);
+			std::cout << charFromPiece(getAt(col, row));
 		}
 		std::cout << std::endl;
 	}
@@ -34,7 +191,7 @@ void Board::charDraw() {
 	std::cout << std::endl << std::endl;
 }
 
-void Board::drawMoves(std::vector<Move> moves) {
+void Board::drawMoves(MoveList &moves) {
 	for (int row = 0; row < BOARD_Y; row++) {
 		std::cout << row << ": ";
 		for (int col = 0; col < BOARD_X; col++) {
@@ -56,7 +213,7 @@ void Board::drawMoves(std::vector<Move> moves) {
 			}
 
 			if (!foundMove) {
-				std::cout << charFromPiece(internalBoard[row][col]);
+				std::cout << charFromPiece(getAt(col, row));
 			}
 		}
 		std::cout << std::endl;
@@ -69,214 +226,469 @@ void Board::drawMoves(std::vector<Move> moves) {
 }
 
 
-std::vector<Move> Board::getAllColorMoves(ColorType ct, bool noCastling) {
-	std::vector<Move> moveAccumulator;
+void Board::addMove(MoveList &moves, MoveType mt, int fromSquare, int toSquare, int captureSquare, PieceType promote) {
+	moves.push_back(Move(mt, fromSquare, toSquare, squares[fromSquare], squares[captureSquare], promote));
+}
 
-	for (int row = 0; row < BOARD_Y; row++) {
-		for (int col = 0; col < BOARD_X; col++) {
-			
-			std::shared_ptr<Piece> pc = getAt(col, row);
+void Board::addTargetMoves(MoveList &moves, int fromSquare, Bitboard targets) {
+	while (targets) {
+		int toSquare = popLsb(targets);
+		MoveType mt = (squares[toSquare] == EMPTY_CODE) ? MoveType::MOVE : MoveType::CAPTURE;
 
-			if (pc->getColorType() == ct) {
-				std::vector<Move> pieceMoves;
+		addMove(moves, mt, fromSquare, toSquare, toSquare);
+	}
+}
 
-				if (pc->getPieceType() == PieceType::KING) {
-					if (noCastling) {
-						pieceMoves = kingMovesNoCastle(pc, *this);
-					} else {
-						pieceMoves = pc->getAllMoves(*this);
-					}
-				} else {
-					pieceMoves = pc->getAllMoves(*this);
-				}
+template<ColorType Us, SliderBackend Backend>
+void Board::addPawnMoves(MoveList &moves, MoveGenType type, Bitboard fromMask, int kingSquare, Bitboard checkMask, Bitboard pinned) {
+	constexpr ColorType Them = ColorTraits<Us>::THEM;
+	constexpr int up = ColorTraits<Us>::UP;
+	constexpr Bitboard lastRow = rowBB(ColorTraits<Us>::LAST_ROW);
+	constexpr Bitboard bigMoveRow = rowBB(ColorTraits<Us>::BIG_MOVE_ROW);
+
+	Bitboard pawns = pieceBB[(int)Us][(int)PieceType::PAWN] & fromMask;
+	Bitboard enemies = colorBB[(int)Them];
+	Bitboard emptyTiles = ~occupiedBB;
+
+	bool wantCaptures = (type == MoveGenType::CAPTURES || type == MoveGenType::ALL);
+	bool wantPromotions = (type == MoveGenType::PROMOTIONS || type == MoveGenType::ALL);
+	bool wantQuiets = (type == MoveGenType::QUIETS || type == MoveGenType::ALL);
+
+	// Every move onto the last row is a promotion, whether it captures or not
+	Bitboard promotionTiles = wantPromotions ? lastRow : EMPTY_BB;
+	Bitboard pushTiles = (wantQuiets ? ~lastRow : EMPTY_BB) | promotionTiles;
+	Bitboard captureTiles = (wantCaptures ? ~lastRow : EMPTY_BB) | promotionTiles;
+
+	Bitboard singlePushes = pawnPushes<Us>(pawns) & emptyTiles;
+	Bitboard doublePushes = wantQuiets ? (pawnPushes<Us>(singlePushes & bigMoveRow) & emptyTiles & checkMask) : EMPTY_BB;
+	Bitboard leftCaptures = shiftLeft(pawnPushes<Us>(pawns)) & enemies & checkMask & captureTiles;
+	Bitboard rightCaptures = shiftRight(pawnPushes<Us>(pawns)) & enemies & checkMask & captureTiles;
+	singlePushes &= checkMask & pushTiles;
+
+	// Each set of destinations and how far its pawns moved
+	Bitboard destinations[3] = { singlePushes, leftCaptures, rightCaptures };
+	int offsets[3] = { up, up - 1, up + 1 };
+
+	for (int i = 0; i < 3; i++) {
+		Bitboard targets = destinations[i];
+		while (targets) {
+			int toSquare = popLsb(targets);
+			int fromSquare = toSquare - offsets[i];
+
+			// A pinned pawn can only move along the line through its king
+			if ((pinned & squareBB(fromSquare)) && !(lineBB[kingSquare][fromSquare] & squareBB(toSquare))) {
+				continue;
+			}
 
-				moveAccumulator.insert(moveAccumulator.end(), pieceMoves.begin(), pieceMoves.end());
+			if (squareBB(toSquare) & lastRow) {
+				addMove(moves, MoveType::PROMOTE, fromSquare, toSquare, toSquare, PieceType::BISHOP);
+				addMove(moves, MoveType::PROMOTE, fromSquare, toSquare, toSquare, PieceType::KNIGHT);
+				addMove(moves, MoveType::PROMOTE, fromSquare, toSquare, toSquare, PieceType::ROOK);
+				addMove(moves, MoveType::PROMOTE, fromSquare, toSquare, toSquare, PieceType::QUEEN);
+			} else {
+				MoveType mt = (i == 0) ? MoveType::MOVE : MoveType::CAPTURE;
+				addMove(moves, mt, fromSquare, toSquare, toSquare);
 			}
+		}
+	}
 
+	while (doublePushes) {
+		int toSquare = popLsb(doublePushes);
+		int fromSquare = toSquare - 2 * up;
+
+		if ((pinned & squareBB(fromSquare)) && !(lineBB[kingSquare][fromSquare] & squareBB(toSquare))) {
+			continue;
 		}
+		addMove(moves, MoveType::PAWN_BIGMOVE, fromSquare, toSquare, toSquare);
 	}
 
-	return moveAccumulator;
-}
+	// En passant onto the tile the enemy pawn skipped, its pawn sits one row behind that tile
+	// The tile belongs to whoever did not make the last move, so make sure the pawn there is an enemy
+	if (wantCaptures && enPassantSquare != NO_SQUARE) {
+		int toSquare = enPassantSquare;
+		int captureSquare = toSquare - up;
 
-void Board::updateCheckStatus() {
+		if (squares[captureSquare] == makePieceCode(PieceType::PAWN, Them)) {
+			Bitboard capturers = PAWN_ATTACKS[(int)Them][toSquare] & pawns;
 
-	// If the Black King is attacked, then black is in check
-	isBlackInCheck = false;
-	std::vector<Move> whiteMoves = getAllColorMoves(ColorType::WHITE);
-	for (Move &mv : whiteMoves) {
-		if (mv.isChecking()) {
-			isBlackInCheck = true;
-			break;
+			while (capturers) {
+				int fromSquare = popLsb(capturers);
+
+				// Both pawns leave the row they shared, which can uncover a slider on the king that no pin shows
+				// Look at the king on the board as it will be after the capture instead of using the masks
+				if (kingSquare >= 0) {
+					Bitboard occupiedAfter = (occupiedBB ^ squareBB(fromSquare) ^ squareBB(captureSquare)) | squareBB(toSquare);
+					if (getColorAttackersTo<Them, Backend>(kingSquare, occupiedAfter) & ~squareBB(captureSquare)) {
+						continue;
+					}
+				}
+				addMove(moves, MoveType::EN_PASSANT, fromSquare, toSquare, captureSquare);
+			}
 		}
 	}
+}
+
+template<ColorType Us, SliderBackend Backend>
+void Board::addCastlingMoves(MoveList &moves) {
+	constexpr int backrow = ColorTraits<Us>::BACK_ROW;
+	constexpr int kingSquare = squareOf(4, backrow);
 
-	// If the White King is attacked, then white is in check
-	isWhiteInCheck = false;
-	std::vector<Move> blackMoves = getAllColorMoves(ColorType::BLACK);
-	for (Move& mv : blackMoves) {
-		if (mv.isChecking()) {
-			isWhiteInCheck = true;
-			break;
+	// Kingside: the rook is on column 7, columns 5 and 6 must be empty and not attacked
+	// Queenside: the rook is on column 0, columns 1 to 3 must be empty, the king crosses columns 2 and 3
+	constexpr MoveType castleTypes[2] = { MoveType::CASTLE_KING, MoveType::CASTLE_QUEEN };
+	constexpr unsigned char sideRights[2] = { ColorTraits<Us>::KINGSIDE, ColorTraits<Us>::QUEENSIDE };
+
+	// A right is lost once the king or that rook leaves home, so holding it means both are still there
+	if (!(castlingRights & (sideRights[0] | sideRights[1])) || isColorInCheck(Us)) {
+		return;
+	}
+
+	constexpr Bitboard emptyMasks[2] = { squareBB(squareOf(5, backrow)) | squareBB(squareOf(6, backrow)),
+		squareBB(squareOf(1, backrow)) | squareBB(squareOf(2, backrow)) | squareBB(squareOf(3, backrow)) };
+	constexpr Bitboard safeMasks[2] = { squareBB(squareOf(5, backrow)) | squareBB(squareOf(6, backrow)),
+		squareBB(squareOf(2, backrow)) | squareBB(squareOf(3, backrow)) };
+
+	// The rook lands next to the king's old tile (destination), the king two tiles over (capture)
+	constexpr int rookDestinations[2] = { squareOf(5, backrow), squareOf(3, backrow) };
+	constexpr int kingDestinations[2] = { squareOf(6, backrow), squareOf(2, backrow) };
+
+	for (int side = 0; side < 2; side++) {
+		if (!(castlingRights & sideRights[side])) {
+			continue;
+		}
+		if (occupiedBB & emptyMasks[side]) {
+			continue;
+		}
+
+		bool crossesAttack = false;
+		Bitboard safeTiles = safeMasks[side];
+		while (safeTiles) {
+			if (isSquareAttackedBy<ColorTraits<Us>::THEM, Backend>(popLsb(safeTiles))) {
+				crossesAttack = true;
+				break;
+			}
+		}
+
+		if (!crossesAttack) {
+			addMove(moves, castleTypes[side], kingSquare, rookDestinations[side], kingDestinations[side]);
 		}
 	}
-	
 }
 
-void Board::enactMove(Move& mv) {
-	moveHistory.push_back(mv);
+void Board::getAttackMaps(Bitboard attacks[2]) {
+	// The sliders of both colors are filled together, then the pawns, knights and kings are added by shifting
+	Bitboard diagonalSliders[2];
+	Bitboard straightSliders[2];
+	for (int color = 0; color < 2; color++) {
+		diagonalSliders[color] = pieceBB[color][(int)PieceType::BISHOP] | pieceBB[color][(int)PieceType::QUEEN];
+		straightSliders[color] = pieceBB[color][(int)PieceType::ROOK] | pieceBB[color][(int)PieceType::QUEEN];
+	}
+	slidingAttackMaps(diagonalSliders, straightSliders, occupiedBB, attacks);
 
-	std::pair<int, int> fromPosition = mv.getFromPosition();
-	std::pair<int, int> destinationPosition = mv.getDestinationPosition();
-	std::pair<int, int> capturePosition = mv.getCapturePosition();
+	for (int color = 0; color < 2; color++) {
+		attacks[color] |= pawnAttacks((ColorType)color, pieceBB[color][(int)PieceType::PAWN]);
+		attacks[color] |= knightAttacks(pieceBB[color][(int)PieceType::KNIGHT]);
+		attacks[color] |= kingAttacks(pieceBB[color][(int)PieceType::KING]);
+	}
+}
 
-	// Custom logic for en passant
-	if (mv.getMoveType() == MoveType::EN_PASSANT) {
+Bitboard Board::getColorAttacks(ColorType ct) {
+	if (ct == ColorType::NONE) {
+		return EMPTY_BB;
+	}
 
-		std::pair<int, int> fromLoc = mv.getFromPosition();
-		std::pair<int, int> destLoc = mv.getDestinationPosition();
-		std::pair<int, int> captLoc = mv.getCapturePosition();
+	Bitboard attacks[2];
+	getAttackMaps(attacks);
+	return attacks[(int)ct];
+}
 
-		std::shared_ptr<Piece> fromEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, fromLoc.first, fromLoc.second));
-		std::shared_ptr<Piece> captEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, captLoc.first, captLoc.second));
+void Board::getAllColorMoves(ColorType ct, MoveList &moveAccumulator, bool noCastling) {
+	if (sliderBackend == SliderBackend::PEXT) {
+		addPseudoLegalMoves<SliderBackend::PEXT>(ct, moveAccumulator, noCastling);
+	} else {
+		addPseudoLegalMoves<SliderBackend::MAGIC>(ct, moveAccumulator, noCastling);
+	}
+}
 
-		std::shared_ptr<Piece> thePawn = getAt(fromLoc.first, fromLoc.second);
-		thePawn->setPosition(destLoc);
-		thePawn->setLastMovedTurn(turnNumber);
+template<SliderBackend Backend>
+void Board::addPseudoLegalMoves(ColorType ct, MoveList &moveAccumulator, bool noCastling) {
+	int color = (int)ct;
+	Bitboard targets = ~colorBB[color];
 
-		internalBoard[destLoc.second][destLoc.first] = thePawn;
-		internalBoard[fromLoc.second][fromLoc.first] = fromEmptyTile;
-		internalBoard[captLoc.second][captLoc.first] = captEmptyTile;
+	if (ct == ColorType::WHITE) {
+		addPawnMoves<ColorType::WHITE, Backend>(moveAccumulator, MoveGenType::ALL, ~EMPTY_BB);
+	} else {
+		addPawnMoves<ColorType::BLACK, Backend>(moveAccumulator, MoveGenType::ALL, ~EMPTY_BB);
+	}
 
-		updateCheckStatus();
-		turnNumber++;
-		return;
+	// Iterate the set bits of each piece bitboard, empty tiles are never visited
+	Bitboard knights = pieceBB[color][(int)PieceType::KNIGHT];
+	while (knights) {
+		int fromSquare = popLsb(knights);
+		addTargetMoves(moveAccumulator, fromSquare, KNIGHT_ATTACKS[fromSquare] & targets);
 	}
 
-	// Custom logic for castling
-	if (mv.getMoveType() == MoveType::CASTLE_KING || mv.getMoveType() == MoveType::CASTLE_QUEEN) {
-	
-		// Kingside castling
-		if (mv.getMoveType() == MoveType::CASTLE_KING) {
-
-			// Change location of rook depending on color
-			std::pair<int, int> rookCornerCoords = (mv.getFromPieceColor() == ColorType::WHITE) ? std::pair<int, int>(7, 7) : std::pair<int, int>(7, 0);
-
-			// Move the king
-			std::pair<int, int> newKingPosition = mv.getCapturePosition();
-			std::pair<int, int> oldKingPosition = mv.getFromPosition();
-			std::shared_ptr<Piece> theKing = getAt(oldKingPosition.first, oldKingPosition.second);
-			theKing->setLastMovedTurn(turnNumber);
-			theKing->setPosition(newKingPosition);
-			internalBoard[newKingPosition.second][newKingPosition.first] = theKing;
-
-			// Put emptyTile on old king position
-			std::shared_ptr<Piece> kingEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldKingPosition.first, oldKingPosition.second));
-			internalBoard[oldKingPosition.second][oldKingPosition.first] = kingEmptyTile;
-
-			// Move the Rook
-			std::pair<int, int> newRookPosition = mv.getDestinationPosition();
-			std::pair<int, int> oldRookPosition = rookCornerCoords;
-			std::shared_ptr<Piece> theRook = getAt(oldRookPosition.first, oldRookPosition.second);
-			theRook->setLastMovedTurn(turnNumber);
-			theRook->setPosition(newRookPosition);
-			internalBoard[newRookPosition.second][newRookPosition.first] = theRook;
-
-			// Put emptyTile on old rook position
-			std::shared_ptr<Piece> rookEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldRookPosition.first, oldRookPosition.second));
-			internalBoard[oldRookPosition.second][oldRookPosition.first] = rookEmptyTile;
+	Bitboard bishops = pieceBB[color][(int)PieceType::BISHOP];
+	while (bishops) {
+		int fromSquare = popLsb(bishops);
+		addTargetMoves(moveAccumulator, fromSquare, bishopAttacks<Backend>(fromSquare, occupiedBB) & targets);
+	}
+
+	Bitboard rooks = pieceBB[color][(int)PieceType::ROOK];
+	while (rooks) {
+		int fromSquare = popLsb(rooks);
+		addTargetMoves(moveAccumulator, fromSquare, rookAttacks<Backend>(fromSquare, occupiedBB) & targets);
+	}
+
+	Bitboard queens = pieceBB[color][(int)PieceType::QUEEN];
+	while (queens) {
+		int fromSquare = popLsb(queens);
+		addTargetMoves(moveAccumulator, fromSquare, queenAttacks<Backend>(fromSquare, occupiedBB) & targets);
+	}
+
+	Bitboard kings = pieceBB[color][(int)PieceType::KING];
+	while (kings) {
+		int fromSquare = popLsb(kings);
+		addTargetMoves(moveAccumulator, fromSquare, KING_ATTACKS[fromSquare] & targets);
+	}
 
+	if (!noCastling) {
+		if (ct == ColorType::WHITE) {
+			addCastlingMoves<ColorType::WHITE, Backend>(moveAccumulator);
 		} else {
-			// Queenside castling
+			addCastlingMoves<ColorType::BLACK, Backend>(moveAccumulator);
+		}
+	}
 
-			int backrow = 7;
-			if (mv.getFromPieceColor() == ColorType::WHITE) {
-				backrow = 7;
-			} else {
-				backrow = 0;
-			}
+}
+
+void Board::clearCheckStatus() {
+	checkStatus[(int)ColorType::WHITE] = -1;
+	checkStatus[(int)ColorType::BLACK] = -1;
+}
+
+bool Board::isSquareAttacked(int square, ColorType byColor) {
+	bool pext = (sliderBackend == SliderBackend::PEXT);
+	if (byColor == ColorType::WHITE) {
+		return pext ? isSquareAttackedBy<ColorType::WHITE, SliderBackend::PEXT>(square) : isSquareAttackedBy<ColorType::WHITE, SliderBackend::MAGIC>(square);
+	} else if (byColor == ColorType::BLACK) {
+		return pext ? isSquareAttackedBy<ColorType::BLACK, SliderBackend::PEXT>(square) : isSquareAttackedBy<ColorType::BLACK, SliderBackend::MAGIC>(square);
+	}
+	return false;
+}
+
+template<ColorType By, SliderBackend Backend>
+bool Board::isSquareAttackedBy(int square) {
+	constexpr int color = (int)By;
+	Bitboard queens = pieceBB[color][(int)PieceType::QUEEN];
+
+	// Put each kind of piece on the square and see if it hits an attacker of the same kind
+	// A pawn attacks the square if a pawn of the other color on the square would attack it back
+	if (PAWN_ATTACKS[(int)ColorTraits<By>::THEM][square] & pieceBB[color][(int)PieceType::PAWN]) {
+		return true;
+	}
+	if (KNIGHT_ATTACKS[square] & pieceBB[color][(int)PieceType::KNIGHT]) {
+		return true;
+	}
+	if (KING_ATTACKS[square] & pieceBB[color][(int)PieceType::KING]) {
+		return true;
+	}
+	if (bishopAttacks<Backend>(square, occupiedBB) & (pieceBB[color][(int)PieceType::BISHOP] | queens)) {
+		return true;
+	}
+	if (rookAttacks<Backend>(square, occupiedBB) & (pieceBB[color][(int)PieceType::ROOK] | queens)) {
+		return true;
+	}
 
-			std::pair<int, int> oldKingPosition = mv.getFromPosition();
-			std::pair<int, int> newKingPosition = mv.getCapturePosition();
-			std::pair<int, int> oldRookPosition = std::pair<int, int>(0, backrow);
-			std::pair<int, int> newRookPosition = mv.getDestinationPosition();
+	return false;
+}
 
-			std::shared_ptr<Piece> theKing = getAt(oldKingPosition.first, oldKingPosition.second);
-			std::shared_ptr<Piece> theRook = getAt(oldRookPosition.first, oldRookPosition.second);
+Bitboard Board::getAttackersTo(int square, Bitboard occupied) {
+	if (sliderBackend == SliderBackend::PEXT) {
+		return getAllAttackersTo<SliderBackend::PEXT>(square, occupied);
+	}
+	return getAllAttackersTo<SliderBackend::MAGIC>(square, occupied);
+}
 
-			// Move king to correct position and put emptyTile in old position
-			internalBoard[newKingPosition.second][newKingPosition.first] = theKing;
-			theKing->setLastMovedTurn(turnNumber);
-			theKing->setPosition(newKingPosition);
-			std::shared_ptr<Piece> kingEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldKingPosition.first, oldKingPosition.second));
-			internalBoard[oldKingPosition.second][oldKingPosition.first] = kingEmptyTile;
+template<SliderBackend Backend>
+Bitboard Board::getAllAttackersTo(int square, Bitboard occupied) {
+	Bitboard diagonalSliders = EMPTY_BB;
+	Bitboard straightSliders = EMPTY_BB;
+	for (int color = 0; color < 2; color++) {
+		diagonalSliders |= pieceBB[color][(int)PieceType::BISHOP] | pieceBB[color][(int)PieceType::QUEEN];
+		straightSliders |= pieceBB[color][(int)PieceType::ROOK] | pieceBB[color][(int)PieceType::QUEEN];
+	}
 
-			// Move rook to correct position and put emptyTile in old position
-			internalBoard[newRookPosition.second][newRookPosition.first] = theRook;
-			theRook->setLastMovedTurn(turnNumber);
-			theRook->setPosition(newRookPosition);
-			std::shared_ptr<Piece> rookEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldRookPosition.first, oldRookPosition.second));
-			internalBoard[oldRookPosition.second][oldRookPosition.first] = rookEmptyTile;
+	int white = (int)ColorType::WHITE;
+	int black = (int)ColorType::BLACK;
 
+	// Same idea as isSquareAttacked, but every attacker is collected instead of stopping at the first one
+	return (PAWN_ATTACKS[black][square] & pieceBB[white][(int)PieceType::PAWN]) |
+		(PAWN_ATTACKS[white][square] & pieceBB[black][(int)PieceType::PAWN]) |
+		(KNIGHT_ATTACKS[square] & (pieceBB[white][(int)PieceType::KNIGHT] | pieceBB[black][(int)PieceType::KNIGHT])) |
+		(KING_ATTACKS[square] & (pieceBB[white][(int)PieceType::KING] | pieceBB[black][(int)PieceType::KING])) |
+		(bishopAttacks<Backend>(square, occupied) & diagonalSliders) |
+		(rookAttacks<Backend>(square, occupied) & straightSliders);
+}
+
+template<ColorType By, SliderBackend Backend>
+Bitboard Board::getColorAttackersTo(int square, Bitboard occupied) {
+	constexpr int color = (int)By;
+	Bitboard queens = pieceBB[color][(int)PieceType::QUEEN];
+
+	return (PAWN_ATTACKS[(int)ColorTraits<By>::THEM][square] & pieceBB[color][(int)PieceType::PAWN]) |
+		(KNIGHT_ATTACKS[square] & pieceBB[color][(int)PieceType::KNIGHT]) |
+		(KING_ATTACKS[square] & pieceBB[color][(int)PieceType::KING]) |
+		(bishopAttacks<Backend>(square, occupied) & (pieceBB[color][(int)PieceType::BISHOP] | queens)) |
+		(rookAttacks<Backend>(square, occupied) & (pieceBB[color][(int)PieceType::ROOK] | queens));
+}
+
+template<ColorType Us, SliderBackend Backend>
+Bitboard Board::getPinnedPieces(int kingSquare) {
+	constexpr int enemy = (int)ColorTraits<Us>::THEM;
+	Bitboard queens = pieceBB[enemy][(int)PieceType::QUEEN];
+
+	// Enemy sliders that would hit the king on an empty board
+	Bitboard snipers = (bishopAttacks<Backend>(kingSquare, EMPTY_BB) & (pieceBB[enemy][(int)PieceType::BISHOP] | queens)) |
+		(rookAttacks<Backend>(kingSquare, EMPTY_BB) & (pieceBB[enemy][(int)PieceType::ROOK] | queens));
+
+	Bitboard pinned = EMPTY_BB;
+	while (snipers) {
+		Bitboard blockers = betweenBB[kingSquare][popLsb(snipers)] & occupiedBB;
+		if (popCount(blockers) == 1) {
+			pinned |= blockers & colorBB[(int)Us];
 		}
+	}
 
-		updateCheckStatus();
-		turnNumber++;
-		return;
+	return pinned;
+}
+
+// The castling rights that survive a move from or to each square
+// Moving the king loses both of its rights, moving or capturing a rook in its corner loses that side
+struct CastlingMasks {
+	unsigned char masks[BOARD_SQUARES];
+};
+
+constexpr CastlingMasks makeCastlingMasks() {
+	CastlingMasks table = {};
+	for (int square = 0; square < BOARD_SQUARES; square++) {
+		table.masks[square] = ALL_CASTLING;
 	}
+	table.masks[squareOf(4, 7)] = ALL_CASTLING & ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+	table.masks[squareOf(7, 7)] = ALL_CASTLING & ~WHITE_KINGSIDE;
+	table.masks[squareOf(0, 7)] = ALL_CASTLING & ~WHITE_QUEENSIDE;
+	table.masks[squareOf(4, 0)] = ALL_CASTLING & ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+	table.masks[squareOf(7, 0)] = ALL_CASTLING & ~BLACK_KINGSIDE;
+	table.masks[squareOf(0, 0)] = ALL_CASTLING & ~BLACK_QUEENSIDE;
+	return table;
+}
+
+constexpr CastlingMasks CASTLING_MASKS = makeCastlingMasks();
+
+void Board::enactMove(Move& mv) {
+	if (colorOf(squares[mv.getFromSquare()]) == ColorType::BLACK) {
+		enactMoveAs<ColorType::BLACK>(mv);
+	} else {
+		enactMoveAs<ColorType::WHITE>(mv);
+	}
+}
+
+template<ColorType Us>
+void Board::enactMoveAs(Move& mv) {
+	int fromSquare = mv.getFromSquare();
+	int destinationSquare = mv.getDestinationSquare();
+	int captureSquare = mv.getCaptureSquare();
+	MoveType mt = mv.getMoveType();
+	bool isCastling = (mt == MoveType::CASTLE_KING || mt == MoveType::CASTLE_QUEEN);
+
+	// Save everything this move overwrites so undoLastMove can copy it back
+	UndoRecord record;
+	record.castlingRights = castlingRights;
+	record.enPassantSquare = enPassantSquare;
+	record.capturedCode = isCastling ? EMPTY_CODE : squares[captureSquare];
+	record.checkStatus[0] = checkStatus[0];
+	record.checkStatus[1] = checkStatus[1];
+	record.halfmoveClock = halfmoveClock;
+	record.zobristKey = zobristKey;
+
+	undoHistory.push_back(record);
+	moveHistory.push_back(mv);
 
-	// Replace capturePosition with emptyTile
-	std::shared_ptr<Piece> capturePiece = getAt(capturePosition.first, capturePosition.second);
-	std::shared_ptr<Piece> captureEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, capturePosition.first, capturePosition.second));
+	// Captures and pawn moves restart the fifty move count
+	if (pieceTypeOf(squares[fromSquare]) == PieceType::PAWN || record.capturedCode != EMPTY_CODE) {
+		halfmoveClock = 0;
+	} else {
+		halfmoveClock++;
+	}
 
-	internalBoard[capturePosition.second][capturePosition.first] = captureEmptyTile;
+	zobristKey ^= ZOBRIST.castling[castlingRights];
+	castlingRights &= CASTLING_MASKS.masks[fromSquare] & CASTLING_MASKS.masks[destinationSquare];
+	zobristKey ^= ZOBRIST.castling[castlingRights];
 
-	// Replace destinationPosition with fromPosition
-	std::shared_ptr<Piece> fromPiece = getAt(fromPosition.first, fromPosition.second);
-	std::shared_ptr<Piece> destinationPiece = getAt(destinationPosition.first, destinationPosition.second);
+	if (enPassantSquare != NO_SQUARE) {
+		zobristKey ^= ZOBRIST.enPassant[squareX(enPassantSquare)];
+		enPassantSquare = NO_SQUARE;
+	}
 
-	internalBoard[destinationPosition.second][destinationPosition.first] = fromPiece;
+	clearCheckStatus();
+	turnNumber++;
 
-	// Update fromPiece's location
-	fromPiece->setPosition(destinationPosition);
-	fromPiece->setLastMovedTurn(turnNumber);
-	
-	// Replace old fromPosition to emptyTile
-	std::shared_ptr<Piece> fromEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, fromPosition.first, fromPosition.second));
+	// Custom logic for en passant
+	if (mt == MoveType::EN_PASSANT) {
 
-	internalBoard[fromPosition.second][fromPosition.first] = fromEmptyTile;
+		// The pawn moves diagonally and captures the pawn beside it
+		removePiece(captureSquare);
+		movePiece(fromSquare, destinationSquare);
+		checkHash();
+		return;
+	}
+
+	// Custom logic for castling
+	if (isCastling) {
+
+		// The king moves to the capture position and the rook to the destination position
+		constexpr int backrow = ColorTraits<Us>::BACK_ROW;
+		int rookColumn = (mt == MoveType::CASTLE_KING) ? 7 : 0;
+
+		movePiece(fromSquare, captureSquare);
+		movePiece(squareOf(rookColumn, backrow), destinationSquare);
+		checkHash();
+		return;
+	}
+
+	// Remove the captured piece
+	if (record.capturedCode != EMPTY_CODE) {
+		removePiece(captureSquare);
+	}
+
+	// Move the piece to the destination
+	movePiece(fromSquare, destinationSquare);
 
 	// Pawn promotion
-	if (mv.getMoveType() == MoveType::PROMOTE) {
-		
-		std::shared_ptr<Piece> promotePiece;
+	if (mt == MoveType::PROMOTE) {
 
 		PieceType promoteType = mv.getPromoteType();
 
-		if (promoteType == PieceType::BISHOP) {
-			promotePiece = std::make_shared<Bishop>(Bishop(fromPiece->getColorType(), destinationPosition.first, destinationPosition.second));
-		} else if (promoteType == PieceType::KNIGHT) {
-			promotePiece = std::make_shared<Knight>(Knight(fromPiece->getColorType(), destinationPosition.first, destinationPosition.second));
-		} else if (promoteType == PieceType::ROOK) {
-			promotePiece = std::make_shared<Rook>(Rook(fromPiece->getColorType(), destinationPosition.first, destinationPosition.second));
-		} else if (promoteType == PieceType::QUEEN) {
-			promotePiece = std::make_shared<Queen>(Queen(fromPiece->getColorType(), destinationPosition.first, destinationPosition.second));
-		} else {
-			// Queen
-			promotePiece = std::make_shared<Queen>(Queen(fromPiece->getColorType(), destinationPosition.first, destinationPosition.second));
+		// Anything that is not a minor piece or rook becomes a queen
+		if (promoteType != PieceType::BISHOP && promoteType != PieceType::KNIGHT && promoteType != PieceType::ROOK) {
+			promoteType = PieceType::QUEEN;
 		}
 
-		promotePiece->setPosition(destinationPosition);
-		promotePiece->setLastMovedTurn(turnNumber);
-
-		internalBoard[destinationPosition.second][destinationPosition.first] = promotePiece;
+		removePiece(destinationSquare);
+		putPiece(destinationSquare, makePieceCode(promoteType, Us));
 	}
 
-	// Detect checks and update bools
-	// TODO:
-	updateCheckStatus();
+	// After a big move the skipped tile can be taken en passant, but only remember it if an enemy pawn is there to do it
+	if (mt == MoveType::PAWN_BIGMOVE) {
+		int skippedSquare = fromSquare + ColorTraits<Us>::UP;
 
-	turnNumber++;
+		if (PAWN_ATTACKS[(int)Us][skippedSquare] & pieceBB[(int)ColorTraits<Us>::THEM][(int)PieceType::PAWN]) {
+			enPassantSquare = skippedSquare;
+			zobristKey ^= ZOBRIST.enPassant[squareX(skippedSquare)];
+		}
+	}
+
+	checkHash();
 }
 
 void Board::undoLastMove() {
@@ -287,150 +699,95 @@ void Board::undoLastMove() {
 	}
 
 	Move lastMove = moveHistory.back();
+	UndoRecord record = undoHistory.back();
 	moveHistory.pop_back();
+	undoHistory.pop_back();
 
-	std::pair<int, int> fromPosition = lastMove.getFromPosition();
-	std::pair<int, int> destinationPosition = lastMove.getDestinationPosition();
-	std::pair<int, int> capturePosition = lastMove.getCapturePosition();
+	// The moved piece, or the rook when castling, is still on the destination
+	if (colorOf(squares[lastMove.getDestinationSquare()]) == ColorType::BLACK) {
+		undoMoveAs<ColorType::BLACK>(lastMove, record);
+	} else {
+		undoMoveAs<ColorType::WHITE>(lastMove, record);
+	}
+}
 
-	// Custom logic for en passant
-	if (lastMove.getMoveType() == MoveType::EN_PASSANT) {
+template<ColorType Us>
+void Board::undoMoveAs(Move &lastMove, UndoRecord &record) {
+	int fromSquare = lastMove.getFromSquare();
+	int destinationSquare = lastMove.getDestinationSquare();
+	int captureSquare = lastMove.getCaptureSquare();
+	MoveType mt = lastMove.getMoveType();
+
+	// Everything the move could not give back is restored from the record, nothing is recomputed
+	castlingRights = record.castlingRights;
+	enPassantSquare = record.enPassantSquare;
+	halfmoveClock = record.halfmoveClock;
+	checkStatus[0] = record.checkStatus[0];
+	checkStatus[1] = record.checkStatus[1];
+	turnNumber--;
 
-		std::pair<int, int> originalLocation = lastMove.getFromPosition();
-		std::pair<int, int> capturePieceLocation = lastMove.getCapturePosition();
-		std::pair<int, int> destinationLocation = lastMove.getDestinationPosition();
+	// Custom logic for en passant and castling
+	if (mt == MoveType::EN_PASSANT) {
 
-		// Move pawn back to original location
-		std::shared_ptr<Piece> thePawn = getAt(destinationLocation.first, destinationLocation.second);
-		thePawn->setPosition(originalLocation);
-		thePawn->setLastMovedTurn(turnNumber - 1);
-		internalBoard[originalLocation.second][originalLocation.first] = thePawn;
+		// Move pawn back to original location and put back the captured pawn
+		movePiece(destinationSquare, fromSquare);
+		putPiece(captureSquare, record.capturedCode);
+	} else if (mt == MoveType::CASTLE_KING || mt == MoveType::CASTLE_QUEEN) {
 
-		// Put empty tile on destination location
-		std::shared_ptr<Piece> pawnEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, destinationLocation.first, destinationLocation.second));
-		internalBoard[destinationLocation.second][destinationLocation.first] = pawnEmptyTile;
+		// Move the king and rook back to their corners
+		constexpr int backrow = ColorTraits<Us>::BACK_ROW;
+		int rookColumn = (mt == MoveType::CASTLE_KING) ? 7 : 0;
 
-		// Recreate captured pawn
-		std::shared_ptr<Piece> recreatedPawn = lastMove.recreateCapturedPiece();
-		recreatedPawn->setPosition(capturePosition);
-		recreatedPawn->setLastMovedTurn(turnNumber - 1);
-		internalBoard[capturePosition.second][capturePosition.first] = recreatedPawn;
+		movePiece(captureSquare, fromSquare);
+		movePiece(destinationSquare, squareOf(rookColumn, backrow));
+	} else {
+		// Put destination piece on from location
+		movePiece(destinationSquare, fromSquare);
 
+		// Undo promotion
+		if (mt == MoveType::PROMOTE) {
+			removePiece(fromSquare);
+			putPiece(fromSquare, makePieceCode(PieceType::PAWN, Us));
+		}
 
-		updateCheckStatus();
-		turnNumber--;
-		return;
+		// Put piece back on capture location
+		if (record.capturedCode != EMPTY_CODE) {
+			putPiece(captureSquare, record.capturedCode);
+		}
 	}
 
-	// Custom logic for castling
-	if (lastMove.getMoveType() == MoveType::CASTLE_KING || lastMove.getMoveType() == MoveType::CASTLE_QUEEN) {
-
-		// Kingside castle
-		if (lastMove.getMoveType() == MoveType::CASTLE_KING) {
-			
-			// Set fixed positions based on color
-			std::pair<int, int> colorBasedCurrentRookPosition = (lastMove.getFromPieceColor() == ColorType::WHITE) ? std::pair<int, int>(5, 7) : std::pair<int, int>(5, 0);
-			std::pair<int, int> colorBasedNewRookPosition     = (lastMove.getFromPieceColor() == ColorType::WHITE) ? std::pair<int, int>(7, 7) : std::pair<int, int>(7, 0);
-			std::pair<int, int> colorBasedCurrentKingPosition = (lastMove.getFromPieceColor() == ColorType::WHITE) ? std::pair<int, int>(6, 7) : std::pair<int, int>(6, 0);
-			std::pair<int, int> colorBasedNewKingPosition     = (lastMove.getFromPieceColor() == ColorType::WHITE) ? std::pair<int, int>(4, 7) : std::pair<int, int>(4, 0);
-
-			// Generic kingside castling undo code
-			std::pair<int, int> currentRookPosition = colorBasedCurrentRookPosition;
-			std::pair<int, int> newRookPosition = colorBasedNewRookPosition;
-			std::shared_ptr<Piece> theRook = getAt(currentRookPosition.first, currentRookPosition.second);
-			theRook->setLastMovedTurn(turnNumber - 1);
-			theRook->setPosition(newRookPosition);
-			internalBoard[newRookPosition.second][newRookPosition.first] = theRook;
-
-			// Place emptyTile on current rook position
-			std::shared_ptr<Piece> rookEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, currentRookPosition.first, currentRookPosition.second));
-			internalBoard[currentRookPosition.second][currentRookPosition.first] = rookEmptyTile;
-
-			// Move king back to center
-			std::pair<int, int> currentKingPosition = colorBasedCurrentKingPosition;
-			std::pair<int, int> newKingPosition = colorBasedNewKingPosition;
-			std::shared_ptr<Piece> theKing = getAt(currentKingPosition.first, currentKingPosition.second);
-			theKing->setLastMovedTurn(turnNumber - 1);
-			theKing->setPosition(newKingPosition);
-			internalBoard[newKingPosition.second][newKingPosition.first] = theKing;
-
-			// Place emptyTile on current king position
-			std::shared_ptr<Piece> kingEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, currentKingPosition.first, currentKingPosition.second));
-			internalBoard[currentKingPosition.second][currentKingPosition.first] = kingEmptyTile;
-
-			// Reset hasMoved on rook and king
-			theKing->setLastMovedTurn(-2);
-			theRook->setLastMovedTurn(-2);
+	// The piece helpers changed the key on the way, the saved key is the one to keep
+	zobristKey = record.zobristKey;
+	checkHash();
+}
 
-		} else {
-			// Queenside castling
+ZobristKey Board::computeHash() {
+	ZobristKey key = 0;
 
-			// Set where the pieces will move to based on color
-			int backrow = 7;
-			if (lastMove.getFromPieceColor() == ColorType::WHITE) {
-				backrow = 7;
-			} else {
-				backrow = 0;
-			}
-
-			std::pair<int, int> oldKingPosition = std::pair<int, int>(2, backrow);
-			std::pair<int, int> newKingPosition = std::pair<int, int>(4, backrow);
-			std::pair<int, int> oldRookPosition = std::pair<int, int>(3, backrow);
-			std::pair<int, int> newRookPosition = std::pair<int, int>(0, backrow);
-
-			std::shared_ptr<Piece> theKing = getAt(oldKingPosition.first, oldKingPosition.second);
-			std::shared_ptr<Piece> theRook = getAt(oldRookPosition.first, oldRookPosition.second);
-
-			// Move king back to original position
-			internalBoard[newKingPosition.second][newKingPosition.first] = theKing;
-			theKing->setPosition(newKingPosition);
-			std::shared_ptr<Piece> kingEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldKingPosition.first, oldKingPosition.second));
-			internalBoard[oldKingPosition.second][oldKingPosition.first] = kingEmptyTile;
-
-			// Move rook back to original position
-			internalBoard[newRookPosition.second][newRookPosition.first] = theRook;
-			theRook->setPosition(newRookPosition);
-			std::shared_ptr<Piece> rookEmptyTile = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, oldRookPosition.first, oldRookPosition.second));
-			internalBoard[oldRookPosition.second][oldRookPosition.first] = rookEmptyTile;
-
-			// Reset hasMoved on rook and king
-			theKing->setLastMovedTurn(-2);
-			theRook->setLastMovedTurn(-2);
-		
+	for (int square = 0; square < BOARD_SQUARES; square++) {
+		if (squares[square] != EMPTY_CODE) {
+			key ^= ZOBRIST.pieces[squares[square]][square];
 		}
-
-		updateCheckStatus();
-		turnNumber--;
-		return;
 	}
 
-	// put destination piece on from location
-	std::shared_ptr<Piece> movedPiece = getAt(destinationPosition.first, destinationPosition.second);
-	internalBoard[destinationPosition.second][destinationPosition.first] = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, destinationPosition.first, destinationPosition.second));
-	internalBoard[fromPosition.second][fromPosition.first] = movedPiece;
-	movedPiece->setPosition(fromPosition);
-	movedPiece->setLastMovedTurn(turnNumber - 1);
-
-	// Reset hasMoved for king
-	if (lastMove.getMoveType() == MoveType::PAWN_BIGMOVE) {
-		movedPiece->setLastMovedTurn(-1); // -1 resets the hasMoved bool to false
+	key ^= ZOBRIST.castling[castlingRights];
+	if (enPassantSquare != NO_SQUARE) {
+		key ^= ZOBRIST.enPassant[squareX(enPassantSquare)];
 	}
-
-	// Put piece back on capture location
-	internalBoard[capturePosition.second][capturePosition.first] = lastMove.recreateCapturedPiece();
-
-	// Undo promotion
-	if (lastMove.getMoveType() == MoveType::PROMOTE) {
-		std::shared_ptr<Piece> depromotedPawn = std::make_shared<Pawn>(Pawn(movedPiece->getColorType(), fromPosition.first, fromPosition.second));
-		depromotedPawn->setPosition(fromPosition);
-		depromotedPawn->setLastMovedTurn(turnNumber - 1);
-
-		internalBoard[fromPosition.second][fromPosition.first] = depromotedPawn;
+	if (turnNumber % 2 == 1) {
+		key ^= ZOBRIST.blackToMove;
 	}
 
-	updateCheckStatus();
+	return key;
+}
 
-	turnNumber--;
+void Board::checkHash() {
+#ifdef DEBUG_HASH
+	if (hash() != computeHash()) {
+		std::cerr << "[HASH] incremental key " << hash() << " does not match recomputed key " << computeHash() << std::endl;
+		std::abort();
+	}
+#endif
 }
 
 Move Board::getLastMove() {
@@ -438,159 +795,268 @@ Move Board::getLastMove() {
 }
 
 bool Board::isColorInCheck(ColorType ct) {
-	switch (ct) {
-		case ColorType::WHITE:
-			return isWhiteInCheck;
-			break;
-		case ColorType::BLACK:
-			return isBlackInCheck;
-			break;
-		case ColorType::NONE:
-			return false;
-			break;
+	if (ct == ColorType::NONE) {
+		return false;
 	}
-	return false;
+
+	int color = (int)ct;
+	if (checkStatus[color] == -1) {
+		// A color is in check when one of its kings is attacked
+		checkStatus[color] = 0;
+
+		Bitboard kings = pieceBB[color][(int)PieceType::KING];
+		while (kings) {
+			if (isSquareAttacked(popLsb(kings), oppositeColor(ct))) {
+				checkStatus[color] = 1;
+				break;
+			}
+		}
+	}
+
+	return checkStatus[color] == 1;
 }
 
-std::vector<Move> Board::getAllValidColorMoves(ColorType ct, bool noCastling) {
-	std::vector<Move> moveAccumulator;
-	
-	for (int row = 0; row < BOARD_Y; row++) {
-		for (int col = 0; col < BOARD_X; col++) {
-			std::shared_ptr<Piece> pc = getAt(col, row);
+// Which kind of move generation produces the move
+static MoveGenType moveGenTypeOf(Move &mv) {
+	switch (mv.getMoveType()) {
+		case MoveType::PROMOTE:
+			return MoveGenType::PROMOTIONS;
+		case MoveType::CAPTURE:
+		case MoveType::EN_PASSANT:
+			return MoveGenType::CAPTURES;
+		default:
+			return MoveGenType::QUIETS;
+	}
+}
+
+void Board::filterLegalMoves(ColorType ct, MoveList &moveAccumulator, MoveGenType type, Bitboard fromMask, bool withCastling) {
+	MoveList pseudoMoves;
+	getAllColorMoves(ct, pseudoMoves, !withCastling);
+
+	// At the end of each move you must be out of check
+	for (Move& mv : pseudoMoves) {
+		if (!(squareBB(mv.getFromSquare()) & fromMask) || (type != MoveGenType::ALL && moveGenTypeOf(mv) != type)) {
+			continue;
+		}
 
-			if (pc->getColorType() == ct) {
-				std::vector<Move> pieceMoves;
+		enactMove(mv);
 
-				if (pc->getPieceType() == PieceType::KING) {
-					if (noCastling) {
-						std::vector<Move> unfilteredKingMoves = kingMovesNoCastle(pc, *this);
-						std::vector<Move> accptedKingMoves;
+		if (!isColorInCheck(ct)) {
+			moveAccumulator.push_back(mv);
+		}
 
-						// Filter king moves for validity
-						for (Move& mv : unfilteredKingMoves) {
-							enactMove(mv);
+		undoLastMove();
+	}
+}
 
-							if (isColorInCheck(mv.getFromPieceColor())) {
+template<ColorType Us, SliderBackend Backend>
+void Board::generateLegalMoves(MoveList &moveAccumulator, MoveGenType type, Bitboard fromMask, bool withCastling) {
+	constexpr ColorType Them = ColorTraits<Us>::THEM;
+	constexpr int color = (int)Us;
+	Bitboard kings = pieceBB[color][(int)PieceType::KING];
 
-							}
-							else {
-								accptedKingMoves.push_back(mv);
-							}
+	// Pins and checks are only defined around a single king
+	if (popCount(kings) != 1) {
+		filterLegalMoves(Us, moveAccumulator, type, fromMask, withCastling);
+		return;
+	}
 
-							undoLastMove();
-						}
+	int kingSquare = lsb(kings);
+	Bitboard enemies = colorBB[(int)Them];
+	Bitboard checkers = getColorAttackersTo<Them, Backend>(kingSquare, occupiedBB);
 
-						pieceMoves = accptedKingMoves;
-					} else {
-						pieceMoves = pc->getValidMoves(*this);
-					}
-				} else {
-					pieceMoves = pc->getValidMoves(*this);
-				}
+	// Captures land on enemies and quiet moves on empty tiles, only pawns promote
+	Bitboard targets = EMPTY_BB;
+	if (type == MoveGenType::CAPTURES || type == MoveGenType::ALL) {
+		targets |= enemies;
+	}
+	if (type == MoveGenType::QUIETS || type == MoveGenType::ALL) {
+		targets |= ~occupiedBB;
+	}
 
-				moveAccumulator.insert(moveAccumulator.end(), pieceMoves.begin(), pieceMoves.end());
-			}
+	// The king may step to any tile the enemy does not attack
+	// The king is lifted off the board first, otherwise it would hide from a slider checking along its own line
+	Bitboard kingTargets = (kings & fromMask) ? (KING_ATTACKS[kingSquare] & targets) : EMPTY_BB;
+	Bitboard safeKingTargets = EMPTY_BB;
+	while (kingTargets) {
+		int toSquare = popLsb(kingTargets);
+		if (!getColorAttackersTo<Them, Backend>(toSquare, occupiedBB ^ kings)) {
+			safeKingTargets |= squareBB(toSquare);
 		}
 	}
+	addTargetMoves(moveAccumulator, kingSquare, safeKingTargets);
+
+	// Nothing but the king can answer two checks at once
+	if (popCount(checkers) > 1) {
+		return;
+	}
+
+	// Out of check any tile will do, in check the other pieces must capture the checker or block it
+	Bitboard checkMask = ~EMPTY_BB;
+	if (checkers) {
+		checkMask = checkers | betweenBB[kingSquare][lsb(checkers)];
+	}
+	targets &= checkMask;
+
+	Bitboard pinned = getPinnedPieces<Us, Backend>(kingSquare);
+
+	addPawnMoves<Us, Backend>(moveAccumulator, type, fromMask, kingSquare, checkMask, pinned);
 
-	return moveAccumulator;
+	// A pinned piece stays on the line through its king and the pinning slider
+	// No knight step keeps to a line, so a pinned knight gets no moves
+	Bitboard knights = pieceBB[color][(int)PieceType::KNIGHT] & ~pinned & fromMask;
+	while (knights) {
+		int fromSquare = popLsb(knights);
+		addTargetMoves(moveAccumulator, fromSquare, KNIGHT_ATTACKS[fromSquare] & targets);
+	}
+
+	Bitboard bishops = pieceBB[color][(int)PieceType::BISHOP] & fromMask;
+	while (bishops) {
+		int fromSquare = popLsb(bishops);
+		Bitboard pinMask = (pinned & squareBB(fromSquare)) ? lineBB[kingSquare][fromSquare] : ~EMPTY_BB;
+		addTargetMoves(moveAccumulator, fromSquare, bishopAttacks<Backend>(fromSquare, occupiedBB) & targets & pinMask);
+	}
+
+	Bitboard rooks = pieceBB[color][(int)PieceType::ROOK] & fromMask;
+	while (rooks) {
+		int fromSquare = popLsb(rooks);
+		Bitboard pinMask = (pinned & squareBB(fromSquare)) ? lineBB[kingSquare][fromSquare] : ~EMPTY_BB;
+		addTargetMoves(moveAccumulator, fromSquare, rookAttacks<Backend>(fromSquare, occupiedBB) & targets & pinMask);
+	}
+
+	Bitboard queens = pieceBB[color][(int)PieceType::QUEEN] & fromMask;
+	while (queens) {
+		int fromSquare = popLsb(queens);
+		Bitboard pinMask = (pinned & squareBB(fromSquare)) ? lineBB[kingSquare][fromSquare] : ~EMPTY_BB;
+		addTargetMoves(moveAccumulator, fromSquare, queenAttacks<Backend>(fromSquare, occupiedBB) & targets & pinMask);
+	}
+
+	// Castling is a quiet king move, it checks the tiles the king crosses itself
+	if (withCastling && !checkers && (kings & fromMask) && (type == MoveGenType::QUIETS || type == MoveGenType::ALL)) {
+		addCastlingMoves<Us, Backend>(moveAccumulator);
+	}
 }
 
-bool Board::isCheckmate(ColorType& thisColor) {
-	// Check to see if white is in checkmate
-	if (isWhiteInCheck) {
-		std::vector<Move> whiteMoves = getAllValidColorMoves(ColorType::WHITE);
-		if (whiteMoves.size() == 0) {
-			thisColor = ColorType::WHITE;
-			return true;
-		}
+template<SliderBackend Backend>
+void Board::generateColorMoves(ColorType ct, MoveList &moveAccumulator, MoveGenType type, Bitboard fromMask, bool withCastling) {
+	if (ct == ColorType::WHITE) {
+		generateLegalMoves<ColorType::WHITE, Backend>(moveAccumulator, type, fromMask, withCastling);
+	} else if (ct == ColorType::BLACK) {
+		generateLegalMoves<ColorType::BLACK, Backend>(moveAccumulator, type, fromMask, withCastling);
 	}
+}
 
-	// Check to see if black is in checkmate
-	if (isWhiteInCheck) {
-		std::vector<Move> blackMoves = getAllValidColorMoves(ColorType::BLACK);
-		if (blackMoves.size() == 0) {
-			thisColor = ColorType::BLACK;
-			return true;
-		}
+void Board::getAllValidColorMoves(ColorType ct, MoveList &moveAccumulator, bool noCastling) {
+	if (sliderBackend == SliderBackend::PEXT) {
+		generateColorMoves<SliderBackend::PEXT>(ct, moveAccumulator, MoveGenType::ALL, ~EMPTY_BB, !noCastling);
+	} else {
+		generateColorMoves<SliderBackend::MAGIC>(ct, moveAccumulator, MoveGenType::ALL, ~EMPTY_BB, !noCastling);
 	}
+}
 
-	return false;
+void Board::getValidColorMoves(ColorType ct, MoveList &moveAccumulator, MoveGenType type, Bitboard fromMask) {
+	if (sliderBackend == SliderBackend::PEXT) {
+		generateColorMoves<SliderBackend::PEXT>(ct, moveAccumulator, type, fromMask, true);
+	} else {
+		generateColorMoves<SliderBackend::MAGIC>(ct, moveAccumulator, type, fromMask, true);
+	}
 }
-bool Board::isStalemate(ColorType& thisColor) {
-	
-	// Check to see if its white's turn and there are no available moves
-	if (getTurnNumber() % 2 == 0) {
-		std::vector<Move> whiteMoves = getAllValidColorMoves(ColorType::WHITE);
-		if ((whiteMoves.size() == 0) && !isColorInCheck(ColorType::WHITE)) {
-			thisColor = ColorType::WHITE;
-			return true;
+
+int Board::repetitionCount() {
+	// Each undo record holds the key from before its move, the last record is one ply back
+	// Only every other ply has the same player to move, and the side to move is not part of the stored keys
+	int count = 0;
+	int oldest = std::max(0, (int)undoHistory.size() - halfmoveClock);
+	for (int i = (int)undoHistory.size() - 2; i >= oldest; i -= 2) {
+		if (undoHistory[i].zobristKey == zobristKey) {
+			count++;
 		}
 	}
 
-	// Check to see if its black's turn and there are no available moves
-	if (getTurnNumber() % 2 == 1) {
-		std::vector<Move> blackMoves = getAllValidColorMoves(ColorType::BLACK);
-		if ((blackMoves.size() == 0) && !isColorInCheck(ColorType::BLACK )) {
-			thisColor = ColorType::BLACK;
-			return true;
+	return count;
+}
+
+bool Board::hasLegalMove(ColorType ct) {
+	if (ct == ColorType::NONE) {
+		return false;
+	}
+
+	// Castling is never the only legal move, the king could also step onto the tile the rook lands on
+	MoveList moves;
+	for (int type = (int)PieceType::PAWN; type <= (int)PieceType::KING; type++) {
+		Bitboard pieces = pieceBB[(int)ct][type];
+		if (pieces) {
+			getValidColorMoves(ct, moves, MoveGenType::ALL, pieces);
+			if (!moves.empty()) {
+				return true;
+			}
 		}
 	}
 
 	return false;
 }
 
-bool Board::isInsuffiantMaterial(ColorType& thisColor) {
-	// View: https://support.chess.com/article/128-what-does-insufficient-mating-material-mean
-
-	bool whiteHasMaterial = true;
-	bool blackHasMaterial = true;
+GameState Board::gameState(MoveList &legalMoves) {
+	ColorType toMove = intToColorType(turnNumber);
 
-	int numberOfWhiteKnights = 0;
-	int numberOfWhiteBishops = 0;
+	int before = legalMoves.size();
+	getAllValidColorMoves(toMove, legalMoves, false);
 
-	int numberOfBlackKnights = 0;
-	int numberOfBlackBishops = 0;
+	if (legalMoves.size() == before) {
+		return isColorInCheck(toMove) ? GameState::CHECKMATE : GameState::STALEMATE;
+	}
 
-	for (int row = 0; row < BOARD_Y; row++) {
-		for (int col = 0; col < BOARD_X; col++) {
-			std::shared_ptr<Piece> currentPiece = getAt(col, row);
-			if (currentPiece->getPieceType() == PieceType::KNIGHT) {
-				if (currentPiece->getColorType() == ColorType::WHITE) {
-					numberOfWhiteKnights++;
-				} else {
-					numberOfBlackKnights++;
-				}
-			} else if (currentPiece->getPieceType() == PieceType::BISHOP) {
-				if (currentPiece->getColorType() == ColorType::WHITE) {
-					numberOfWhiteBishops++;
-				} else {
-					numberOfBlackBishops++;
-				}
-			} else if (currentPiece->getPieceType() == PieceType::KING) {
-				// There is always a king
-			} else if (currentPiece->getPieceType() == PieceType::EMPTY_TILE) {
-				// Ignore empty tiles
-			} else {
-				// Any other piece on the board means there is not insuffiant material
-				return false;
-			}
-		}
+	ColorType noMatColor = ColorType::NONE;
+	if (isInsuffiantMaterial(noMatColor)) {
+		return GameState::INSUFFICIENT_MATERIAL;
+	}
+	if (isThreefoldRepetition()) {
+		return GameState::THREEFOLD_REPETITION;
+	}
+	if (isFiftyMoveRule()) {
+		return GameState::FIFTY_MOVES;
 	}
 
-	// White doesn't have the material
-	if ((numberOfWhiteBishops == 1 && numberOfWhiteKnights == 0) || (numberOfWhiteBishops == 0 && numberOfWhiteKnights == 1) || 
-		(numberOfWhiteBishops == 0 && numberOfWhiteKnights == 0)) {
+	return GameState::ONGOING;
+}
 
-		whiteHasMaterial = false;
+GameState Board::gameState() {
+	ColorType toMove = intToColorType(turnNumber);
+
+	if (!hasLegalMove(toMove)) {
+		return isColorInCheck(toMove) ? GameState::CHECKMATE : GameState::STALEMATE;
 	}
-	// Black doesn't have the material
-	if ((numberOfBlackBishops == 1 && numberOfBlackKnights == 0) || (numberOfBlackBishops == 0 && numberOfBlackKnights == 1) || 
-		(numberOfBlackBishops == 0 && numberOfBlackKnights == 0)) {
 
-		blackHasMaterial = false;
+	ColorType noMatColor = ColorType::NONE;
+	if (isInsuffiantMaterial(noMatColor)) {
+		return GameState::INSUFFICIENT_MATERIAL;
+	}
+	if (isThreefoldRepetition()) {
+		return GameState::THREEFOLD_REPETITION;
 	}
+	if (isFiftyMoveRule()) {
+		return GameState::FIFTY_MOVES;
+	}
+
+	return GameState::ONGOING;
+}
+
+bool Board::isInsuffiantMaterial(ColorType& thisColor) {
+	// View: https://support.chess.com/article/128-what-does-insufficient-mating-material-mean
+
+	// Any pawn, rook or queen on the board means there is not insuffiant material
+	MaterialKey minorsAndKings = 0;
+	for (ColorType ct : { ColorType::WHITE, ColorType::BLACK }) {
+		minorsAndKings |= materialKeyOf(ct, PieceType::KNIGHT, MATERIAL_KEY_MAX_COUNT) | materialKeyOf(ct, PieceType::BISHOP, MATERIAL_KEY_MAX_COUNT) |
+			materialKeyOf(ct, PieceType::KING, MATERIAL_KEY_MAX_COUNT);
+	}
+	if (materialKey & ~minorsAndKings) {
+		return false;
+	}
+
+	// A color without the material has at most one knight or bishop
+	bool whiteHasMaterial = pieceCounts[(int)ColorType::WHITE][(int)PieceType::KNIGHT] + pieceCounts[(int)ColorType::WHITE][(int)PieceType::BISHOP] > 1;
+	bool blackHasMaterial = pieceCounts[(int)ColorType::BLACK][(int)PieceType::KNIGHT] + pieceCounts[(int)ColorType::BLACK][(int)PieceType::BISHOP] > 1;
 
 	return !whiteHasMaterial && !blackHasMaterial;
 }
@@ -609,17 +1075,17 @@ bool Board::validate() {
 
 	for (int row = 0; row < BOARD_Y; row++) {
 		for (int col = 0; col < BOARD_X; col++) {
-			std::shared_ptr<Piece> pn = getAt(col, row);
+			PieceCode pn = getAt(col, row);
 
-			if (pn->getPieceType() == PieceType::PAWN) {
+			if (pieceTypeOf(pn) == PieceType::PAWN) {
 				// Check for pawns on 0th and 7th row
 				if ((row == 0) || (row == 7)) {
 					noPawnsOnBackrow = false;
 				}
 			}
 
-			if (pn->getPieceType() == PieceType::KING) {
-				if (pn->getColorType() == ColorType::WHITE) {
+			if (pieceTypeOf(pn) == PieceType::KING) {
+				if (colorOf(pn) == ColorType::WHITE) {
 					numberOfWhiteKings++;
 				} else {
 					numberOfBlackKings++;
@@ -628,7 +1094,7 @@ bool Board::validate() {
 		}
 	}
 
-	updateCheckStatus();
+	clearCheckStatus();
 
 	bool whiteCheck = isColorInCheck(ColorType::WHITE);
 	bool blackCheck = isColorInCheck(ColorType::BLACK);
@@ -646,9 +1112,9 @@ void Board::drawChars() {
 			int whiteOrBlackSquare = (col + row) % 2; // 0 is white, 1 is black
 			ColorType tileColor = intToColorType(whiteOrBlackSquare);
 
-			std::shared_ptr<Piece> piece = getAt(col, row);
+			PieceCode piece = getAt(col, row);
 
-			if (piece->getPieceType() == PieceType::EMPTY_TILE) {
+			if (piece == EMPTY_CODE) {
 				if (tileColor == ColorType::WHITE) {
 					std::cout << " ";
 				} else {
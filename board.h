@@ -1,35 +1,202 @@
 #ifndef _HEADER_BOARD_H_
 #define _HEADER_BOARD_H_
 
-#include <memory>
+#include <algorithm>
 #include <iostream>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
 
+#include "piececode.h"
+#include "bitboard.h"
+#include "magic.h"
+#include "koggestone.h"
+#include "zobrist.h"
 #include "move.h"
-#include "piece.h"
+#include "movelist.h"
 #include "utilities.h"
 
 // Window and lX11
 #include "window.h"
 class Xwindow;
 
-class Piece;
 class Move;
-enum class ColorType;
+class MoveList;
+enum class MoveType;
 
 const int BOARD_X = 8;
 const int BOARD_Y = 8;
 
+const int BOARD_SQUARES = BOARD_X * BOARD_Y;
+
+// Castling rights are one bit per color and side
+const unsigned char WHITE_KINGSIDE = 1;
+const unsigned char WHITE_QUEENSIDE = 2;
+const unsigned char BLACK_KINGSIDE = 4;
+const unsigned char BLACK_QUEENSIDE = 8;
+const unsigned char ALL_CASTLING = WHITE_KINGSIDE | WHITE_QUEENSIDE | BLACK_KINGSIDE | BLACK_QUEENSIDE;
+
+const int NO_SQUARE = -1;
+
+// The number of pieces of each color and type packed four bits each, the same key means the same material
+// Two positions can share it with their pieces on different tiles, it identifies endgames such as KBN vs K
+// A setup board can hold more pieces of a type than a field fits, counts stop at MATERIAL_KEY_MAX_COUNT
+// so they never carry into the next field, a field is still only 0 when there is no such piece
+typedef unsigned long long MaterialKey;
+const int MATERIAL_KEY_MAX_COUNT = 15;
+
+constexpr int materialKeyShift(ColorType ct, PieceType pt) {
+	return ((int)ct * 6 + (int)pt) * 4;
+}
+
+constexpr MaterialKey materialKeyOf(ColorType ct, PieceType pt, int count) {
+	return (MaterialKey)count << materialKeyShift(ct, pt);
+}
+
+// The constants of one side, move generation and make/unmake are templated on the side to move
+// so these fold into the code instead of being picked at run time
+template<ColorType Us>
+struct ColorTraits {
+	static constexpr ColorType THEM = (Us == ColorType::WHITE) ? ColorType::BLACK : ColorType::WHITE;
+	// Moving forwards one row changes the square index by UP
+	static constexpr int UP = (Us == ColorType::WHITE) ? -BOARD_X : BOARD_X;
+	static constexpr int BACK_ROW = (Us == ColorType::WHITE) ? 7 : 0;
+	static constexpr int LAST_ROW = (Us == ColorType::WHITE) ? 0 : 7;
+	// A pawn that single pushes onto this row may push again
+	static constexpr int BIG_MOVE_ROW = (Us == ColorType::WHITE) ? 5 : 2;
+	static constexpr unsigned char KINGSIDE = (Us == ColorType::WHITE) ? WHITE_KINGSIDE : BLACK_KINGSIDE;
+	static constexpr unsigned char QUEENSIDE = (Us == ColorType::WHITE) ? WHITE_QUEENSIDE : BLACK_QUEENSIDE;
+};
+
+// How the game stands for the side to move
+enum class GameState { ONGOING, CHECKMATE, STALEMATE, INSUFFICIENT_MATERIAL, THREEFOLD_REPETITION, FIFTY_MOVES };
+
+// The kinds of move a generator can be asked for
+// Promotions include capturing promotions, quiet moves include castling
+enum class MoveGenType { CAPTURES, PROMOTIONS, QUIETS, ALL };
+
+// The state a move destroys and that cannot be worked out from the move itself
+// enactMove pushes one record per ply and undoLastMove copies it back
+struct UndoRecord {
+	unsigned char castlingRights;
+	signed char enPassantSquare;
+	PieceCode capturedCode;
+	signed char checkStatus[2];
+	int halfmoveClock;
+	ZobristKey zobristKey;
+};
+
+// Everything that describes a position and nothing else, with no pointers or containers inside
+// It can be copied with memcpy, which makes it cheap to hand a position to another thread or to keep one
+// per ply for copy-make instead of undoing moves
+// The pieces are stored as one bitboard per color and one per piece type, the mailbox is rebuilt on load
+struct BoardSnapshot {
+	Bitboard colorBB[2];
+	Bitboard typeBB[6];
+	ZobristKey zobristKey;
+	int turnNumber;
+	int halfmoveClock;
+	unsigned char castlingRights;
+	signed char enPassantSquare;
+	signed char checkStatus[2];
+};
+
+static_assert(sizeof(BoardSnapshot) <= 128, "a BoardSnapshot must fit in two cache lines");
+static_assert(std::is_trivially_copyable<BoardSnapshot>::value, "a BoardSnapshot must be memcpy-able");
+
 class Board {
 
 	std::vector<Move> moveHistory;
+	std::vector<UndoRecord> undoHistory;
+
+	// Castling still allowed to each color and side, cleared once a king or rook leaves its home tile
+	unsigned char castlingRights;
+
+	// The tile skipped by a pawn that just moved two rows, when an enemy pawn could capture onto it, NO_SQUARE otherwise
+	int enPassantSquare;
+
+	// Plies since the last capture or pawn move
+	int halfmoveClock;
+
+	// Zobrist key of the pieces, castling rights and en passant square, kept up to date by every change to them
+	// The side to move is added by hash() so the public turnNumber can never put it out of step
+	ZobristKey zobristKey;
+
+	// Builds with -DDEBUG_HASH compare the incremental key against computeHash() after every move and undo
+	void checkHash();
+
+	// Mailbox of PieceCodes, a tile (x, y) is stored at index y * BOARD_X + x
+	PieceCode squares[BOARD_SQUARES];
+
+	// One bitboard per color and piece type, plus the union of each color and of the whole board
+	Bitboard pieceBB[2][6];
+	Bitboard colorBB[2];
+	Bitboard occupiedBB;
+
+	// Piece counts, the getPiecePoints() total of each color and the material key, kept up to date by putPiece and removePiece
+	int pieceCounts[2][6];
+	int material[2];
+	MaterialKey materialKey;
+	void resetMaterial();
 
-	std::shared_ptr<Piece> internalBoard[BOARD_Y][BOARD_X];
+	// Add, remove and move pieces while keeping the bitboards and material in sync with the mailbox
+	void putPiece(int square, PieceCode pc);
+	void removePiece(int square);
+	void movePiece(int fromSquare, int toSquare);
+
+	// Move generation helpers, the pieces involved in a move are read from the board
+	void addMove(MoveList &moves, MoveType mt, int fromSquare, int toSquare, int captureSquare, PieceType promote = PieceType::PAWN);
+	void addTargetMoves(MoveList &moves, int fromSquare, Bitboard targets);
+	// Only pawns on fromMask are used, with a kingSquare only the pawn moves that keep that king safe are added
+	// Everything that looks up slider attacks takes the backend in use as Backend, see generateColorMoves
+	template<ColorType Us, SliderBackend Backend>
+	void addPawnMoves(MoveList &moves, MoveGenType type, Bitboard fromMask, int kingSquare = -1, Bitboard checkMask = ~EMPTY_BB, Bitboard pinned = EMPTY_BB);
+	template<ColorType Us, SliderBackend Backend>
+	void addCastlingMoves(MoveList &moves);
+
+	// getAllColorMoves for one backend
+	template<SliderBackend Backend>
+	void addPseudoLegalMoves(ColorType ct, MoveList &moves, bool noCastling);
+
+	// enactMove and undoLastMove for a move made by color Us
+	template<ColorType Us>
+	void enactMoveAs(Move &mv);
+	template<ColorType Us>
+	void undoMoveAs(Move &mv, UndoRecord &record);
+
+	// Attack tests for the pieces of color By only
+	template<ColorType By, SliderBackend Backend>
+	bool isSquareAttackedBy(int square);
+	template<ColorType By, SliderBackend Backend>
+	Bitboard getColorAttackersTo(int square, Bitboard occupied);
+
+	// getAttackersTo for one backend
+	template<SliderBackend Backend>
+	Bitboard getAllAttackersTo(int square, Bitboard occupied);
 
 	void loadBoard(char charBoard[8][8]);
 
 	void charDraw();
 
-	void updateCheckStatus();
+	// Whether each color is in check, -1 until isColorInCheck computes it
+	// Enacting or undoing a move only forgets the cached values, nothing is computed until someone asks
+	signed char checkStatus[2];
+
+	// The pieces of color Us standing alone between their king and an enemy slider
+	template<ColorType Us, SliderBackend Backend>
+	Bitboard getPinnedPieces(int kingSquare);
+
+	// Legal moves of the given kind made by the pieces on fromMask, from the pins and checks around the king
+	template<ColorType Us, SliderBackend Backend>
+	void generateLegalMoves(MoveList &moves, MoveGenType type, Bitboard fromMask, bool withCastling);
+
+	// generateLegalMoves for the color ct. The public generators read sliderBackend here, once per call,
+	// so none of the lookups below them test it
+	template<SliderBackend Backend>
+	void generateColorMoves(ColorType ct, MoveList &moves, MoveGenType type, Bitboard fromMask, bool withCastling);
+
+	// Plays every pseudo legal move and keeps those that leave no king of color ct attacked
+	void filterLegalMoves(ColorType ct, MoveList &moves, MoveGenType type, Bitboard fromMask, bool withCastling);
 
 	public:
 		Board(char customBoard[8][8] = nullptr) {
@@ -50,6 +217,14 @@ class Board {
 				loadBoard(customBoard);
 			}
 		}
+		explicit Board(const BoardSnapshot &snapshot) {
+			loadSnapshot(snapshot);
+		}
+		// Copies the current position out, the move history is not part of it
+		BoardSnapshot getSnapshot();
+		// Replaces the position with the snapshot and forgets the move history, moves made before cannot be undone
+		// For copy-make, take a snapshot before enacting a move and load it back instead of calling undoLastMove
+		void loadSnapshot(const BoardSnapshot &snapshot);
 		bool tileExists(int x, int y) {
 			if (((0 <= x) && (x < BOARD_X)) && ((0 <= y) && (y < BOARD_Y))) {
 				return true;
@@ -61,35 +236,96 @@ class Board {
 		void draw() {
 			charDraw();
 		}
-		void drawMoves(std::vector<Move> moves);
-		std::shared_ptr<Piece> getAt(int x, int y) {
-			return internalBoard[y][x];
+		void drawMoves(MoveList &moves);
+		PieceCode getAt(int x, int y) {
+			return squares[y * BOARD_X + x];
+		}
+		Bitboard getPieces(ColorType ct, PieceType pt) {
+			return pieceBB[(int)ct][(int)pt];
 		}
+		Bitboard getColorPieces(ColorType ct) {
+			return colorBB[(int)ct];
+		}
+		Bitboard getOccupied() {
+			return occupiedBB;
+		}
+		int getPieceCount(ColorType ct, PieceType pt) {
+			return pieceCounts[(int)ct][(int)pt];
+		}
+		// The sum of getPiecePoints() over the pieces of color ct
+		int getMaterial(ColorType ct) {
+			return material[(int)ct];
+		}
+		MaterialKey getMaterialKey() {
+			return materialKey;
+		}
+		// Returns every tile attacked by a piece of color ct
+		Bitboard getColorAttacks(ColorType ct);
+		// Every tile attacked by each color, index by ColorType, the sliders come from Kogge-Stone fills
+		void getAttackMaps(Bitboard attacks[2]);
 		int turnNumber = 0;
-		std::vector<Move> getAllColorMoves(ColorType ct, bool noCastling = true);
+		// Move generators append to the list they are given
+		void getAllColorMoves(ColorType ct, MoveList &moves, bool noCastling = true);
 		void enactMove(Move &mv);
 		void undoLastMove();
 		Move getLastMove();
+		unsigned char getCastlingRights() {
+			return castlingRights;
+		}
+		int getEnPassantSquare() {
+			return enPassantSquare;
+		}
+		int getHalfmoveClock() {
+			return halfmoveClock;
+		}
+		// Identifies the position: pieces, side to move, castling rights and en passant square
+		ZobristKey hash() {
+			return zobristKey ^ ((turnNumber % 2 == 1) ? ZOBRIST.blackToMove : 0);
+		}
+		// The key hash() should return, rebuilt from nothing
+		ZobristKey computeHash();
 		int numberOfMoves() {
 			return moveHistory.size();
 		}
-		bool isWhiteInCheck = false;
-		bool isBlackInCheck = false;
 		bool isColorInCheck(ColorType ct);
-		std::vector<Move> getAllValidColorMoves(ColorType ct, bool noCastling = true);
+		// Forgets the cached check status of both colors, the next isColorInCheck computes it again
+		void clearCheckStatus();
+		// Determines if a piece of color byColor attacks the square, looking outwards from the square
+		bool isSquareAttacked(int square, ColorType byColor);
+		// Every piece of either color attacking the square when the board holds the pieces in occupied
+		Bitboard getAttackersTo(int square, Bitboard occupied);
+		void getAllValidColorMoves(ColorType ct, MoveList &moves, bool noCastling = true);
+		// Only the legal moves of one kind, optionally only those of the pieces on fromMask
+		// Castling is included with the quiet moves
+		void getValidColorMoves(ColorType ct, MoveList &moves, MoveGenType type, Bitboard fromMask = ~EMPTY_BB);
 		int getTurnNumber() {
 			return turnNumber;
 		}
 		void setTurnNumber(int value) {
 			turnNumber = value;
 		}
-		bool isCheckmate(ColorType &thisColor);
-		bool isStalemate(ColorType &thisColor);
+		// How many earlier positions of the game are the same as this one, with the same player to move
+		// Only the positions since the last capture or pawn move are looked at, nothing before them can repeat
+		int repetitionCount();
+		bool isThreefoldRepetition() {
+			return repetitionCount() >= 2;
+		}
+		// A hundred plies without a capture or pawn move
+		bool isFiftyMoveRule() {
+			return halfmoveClock >= 100;
+		}
+		// Whether color ct has at least one legal move, generation stops at the first kind of piece that has one
+		bool hasLegalMove(ColorType ct);
+		// Checkmate, stalemate and the draws for the side to move, from one generation of its moves
+		// The legal moves, castling included, are appended to legalMoves so the caller does not generate them again
+		GameState gameState(MoveList &legalMoves);
+		// The same when the moves are not needed, only looks for one legal move
+		GameState gameState();
 		bool isInsuffiantMaterial(ColorType &thisColor);
 		bool validate();
 		void drawChars();
 		void lX11Draw(Xwindow &xw);
-		std::vector<Move> getMoveHistory() {
+		const std::vector<Move> &getMoveHistory() {
 			return moveHistory;
 		}
 };
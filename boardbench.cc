@@ -0,0 +1,210 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "agent.h"
+#include "bench.h"
+#include "magic.h"
+#include "window.h"
+
+// Times the Board primitives one at a time over the bench positions and prints ns per operation as JSON
+// Each primitive runs SAMPLES timed passes over the corpus after one untimed pass, the mean, variance,
+// standard deviation and minimum are over those passes, so a change can be traced to the primitive it moved
+
+const int SAMPLES = 10;
+
+// The ns per operation of each pass of one primitive, or why it could not be run
+struct Measurement {
+	std::string name;
+	bool available;
+	std::string reason;
+	unsigned long long opsPerSample;
+	std::vector<double> samples;
+};
+
+// Folded into by every primitive so the compiler cannot drop the work
+unsigned long long sink = 0;
+
+// pass runs one pass over the corpus and returns the number of operations it timed
+template<typename Pass>
+Measurement measure(const std::string &name, Pass pass) {
+	Measurement measurement{ name, true, "", 0, {} };
+
+	pass();
+	for (int i = 0; i < SAMPLES; i++) {
+		auto start = std::chrono::steady_clock::now();
+		unsigned long long ops = pass();
+		auto end = std::chrono::steady_clock::now();
+
+		measurement.opsPerSample = ops;
+		measurement.samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / std::max(ops, 1ULL));
+	}
+
+	return measurement;
+}
+
+Measurement unavailable(const std::string &name, const std::string &reason) {
+	return Measurement{ name, false, reason, 0, {} };
+}
+
+void printJson(const std::vector<Measurement> &measurements) {
+	std::cout << "{" << std::endl;
+	std::cout << "  \"positions\": " << BENCH_POSITION_COUNT << "," << std::endl;
+	std::cout << "  \"samples\": " << SAMPLES << "," << std::endl;
+	std::cout << "  \"sliderBackend\": \"" << sliderBackendName(sliderBackend) << "\"," << std::endl;
+	std::cout << "  \"results\": [" << std::endl;
+
+	for (size_t i = 0; i < measurements.size(); i++) {
+		const Measurement &m = measurements[i];
+		std::cout << "    { \"name\": \"" << m.name << "\", \"available\": " << (m.available ? "true" : "false");
+
+		if (m.available) {
+			double mean = 0;
+			double minimum = m.samples[0];
+			for (double sample : m.samples) {
+				mean += sample;
+				minimum = std::min(minimum, sample);
+			}
+			mean /= m.samples.size();
+
+			double variance = 0;
+			for (double sample : m.samples) {
+				variance += (sample - mean) * (sample - mean);
+			}
+			variance /= m.samples.size();
+
+			std::cout << ", \"opsPerSample\": " << m.opsPerSample << ", \"meanNs\": " << mean << ", \"varianceNs2\": " << variance
+				<< ", \"stddevNs\": " << std::sqrt(variance) << ", \"minNs\": " << minimum;
+		} else {
+			std::cout << ", \"reason\": \"" << m.reason << "\"";
+		}
+
+		std::cout << " }" << ((i + 1 < measurements.size()) ? "," : "") << std::endl;
+	}
+
+	std::cout << "  ]" << std::endl;
+	std::cout << "}" << std::endl;
+}
+
+int main() {
+	initMagics();
+
+	std::vector<Board> boards;
+	std::vector<MoveList> legalMoves;
+	for (int i = 0; i < BENCH_POSITION_COUNT; i++) {
+		boards.push_back(loadBenchPosition(BENCH_POSITIONS[i]));
+		legalMoves.push_back(MoveList());
+		boards.back().getAllValidColorMoves(intToColorType(boards.back().getTurnNumber()), legalMoves.back(), false);
+	}
+
+	std::vector<Measurement> measurements;
+
+	measurements.push_back(measure("enactMove+undoLastMove", [&]() {
+		unsigned long long ops = 0;
+		for (int repeat = 0; repeat < 200; repeat++) {
+			for (size_t i = 0; i < boards.size(); i++) {
+				for (Move &mv : legalMoves[i]) {
+					boards[i].enactMove(mv);
+					boards[i].undoLastMove();
+					ops++;
+				}
+			}
+		}
+		return ops;
+	}));
+
+	measurements.push_back(measure("getAllColorMoves", [&]() {
+		unsigned long long ops = 0;
+		for (int repeat = 0; repeat < 200; repeat++) {
+			for (Board &board : boards) {
+				MoveList moves;
+				board.getAllColorMoves(intToColorType(board.getTurnNumber()), moves);
+				sink += moves.size();
+				ops++;
+			}
+		}
+		return ops;
+	}));
+
+	measurements.push_back(measure("getAllValidColorMoves", [&]() {
+		unsigned long long ops = 0;
+		for (int repeat = 0; repeat < 200; repeat++) {
+			for (Board &board : boards) {
+				MoveList moves;
+				board.getAllValidColorMoves(intToColorType(board.getTurnNumber()), moves);
+				sink += moves.size();
+				ops++;
+			}
+		}
+		return ops;
+	}));
+
+	// updateCheckStatus is now the lazy isColorInCheck, the cache is cleared so every call computes it
+	measurements.push_back(measure("isColorInCheck", [&]() {
+		unsigned long long ops = 0;
+		for (int repeat = 0; repeat < 2000; repeat++) {
+			for (Board &board : boards) {
+				board.clearCheckStatus();
+				sink += board.isColorInCheck(intToColorType(board.getTurnNumber()));
+				ops++;
+			}
+		}
+		return ops;
+	}));
+
+	measurements.push_back(measure("isInsuffiantMaterial", [&]() {
+		unsigned long long ops = 0;
+		for (int repeat = 0; repeat < 2000; repeat++) {
+			for (Board &board : boards) {
+				ColorType ct = intToColorType(board.getTurnNumber());
+				sink += board.isInsuffiantMaterial(ct);
+				ops++;
+			}
+		}
+		return ops;
+	}));
+
+	// The bots break ties at random, the move they pick is not checked
+	for (int level = 1; level <= 4; level++) {
+		Bot bot(level);
+		measurements.push_back(measure("Bot::getMove level " + std::to_string(level), [&]() {
+			unsigned long long ops = 0;
+			for (int repeat = 0; repeat < 20; repeat++) {
+				for (size_t i = 0; i < boards.size(); i++) {
+					if (legalMoves[i].size() == 0) {
+						continue;
+					}
+					Move mv = bot.getMove(boards[i], intToColorType(boards[i].getTurnNumber()), legalMoves[i]);
+					sink += mv.getFromSquare();
+					ops++;
+				}
+			}
+			return ops;
+		}));
+	}
+
+	// Xwindow exits when there is no display, only run it when one opens (a real one or Xvfb)
+	Display *display = XOpenDisplay(0);
+	if (display == 0) {
+		measurements.push_back(unavailable("Xwindow::load", "no X display, run under Xvfb to time it"));
+	} else {
+		XCloseDisplay(display);
+
+		Xwindow window(boards[0]);
+		measurements.push_back(measure("Xwindow::load", [&]() {
+			// Every load changes the board shown, so each one has tiles to redraw
+			for (Board &board : boards) {
+				window.load(board);
+			}
+			return (unsigned long long)boards.size();
+		}));
+	}
+
+	printJson(measurements);
+	std::cerr << "checksum " << sink << std::endl;
+
+	return 0;
+}
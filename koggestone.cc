@@ -0,0 +1,174 @@
+#include "koggestone.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KOGGESTONE_X86
+#include <immintrin.h>
+#endif
+
+// Shifting left moves a tile towards h1: 1 is one column right, 8 one row down, 9 and 7 the two diagonals below
+// Shifting right goes the other way. A shift that moves a column must not wrap a tile onto the far side of
+// the board, so the tiles it lands on are masked with the columns it cannot reach
+const Bitboard NOT_FILE_A = ~FILE_A_BB;
+const Bitboard NOT_FILE_H = ~FILE_H_BB;
+
+static Bitboard fillLeft(Bitboard gen, Bitboard empty, int shift, Bitboard wrap) {
+	Bitboard pro = empty & wrap;
+	gen |= pro & (gen << shift);
+	pro &= pro << shift;
+	gen |= pro & (gen << (2 * shift));
+	pro &= pro << (2 * shift);
+	gen |= pro & (gen << (4 * shift));
+	return (gen << shift) & wrap;
+}
+
+static Bitboard fillRight(Bitboard gen, Bitboard empty, int shift, Bitboard wrap) {
+	Bitboard pro = empty & wrap;
+	gen |= pro & (gen >> shift);
+	pro &= pro >> shift;
+	gen |= pro & (gen >> (2 * shift));
+	pro &= pro >> (2 * shift);
+	gen |= pro & (gen >> (4 * shift));
+	return (gen >> shift) & wrap;
+}
+
+void slidingAttackMapsScalar(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]) {
+	Bitboard empty = ~occupied;
+
+	for (int color = 0; color < 2; color++) {
+		Bitboard straight = straightSliders[color];
+		Bitboard diagonal = diagonalSliders[color];
+
+		attacks[color] = fillLeft(straight, empty, 1, NOT_FILE_A) | fillRight(straight, empty, 1, NOT_FILE_H) |
+			fillLeft(straight, empty, 8, ~EMPTY_BB) | fillRight(straight, empty, 8, ~EMPTY_BB) |
+			fillLeft(diagonal, empty, 9, NOT_FILE_A) | fillRight(diagonal, empty, 9, NOT_FILE_H) |
+			fillLeft(diagonal, empty, 7, NOT_FILE_H) | fillRight(diagonal, empty, 7, NOT_FILE_A);
+	}
+}
+
+#ifdef KOGGESTONE_X86
+
+// SSE2 has no shift with a different count per lane, so each vector holds one direction for both colors
+template<int Shift>
+static __m128i fillLeftSse2(__m128i gen, __m128i empty, __m128i wrap) {
+	__m128i pro = _mm_and_si128(empty, wrap);
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_slli_epi64(gen, Shift)));
+	pro = _mm_and_si128(pro, _mm_slli_epi64(pro, Shift));
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_slli_epi64(gen, 2 * Shift)));
+	pro = _mm_and_si128(pro, _mm_slli_epi64(pro, 2 * Shift));
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_slli_epi64(gen, 4 * Shift)));
+	return _mm_and_si128(_mm_slli_epi64(gen, Shift), wrap);
+}
+
+template<int Shift>
+static __m128i fillRightSse2(__m128i gen, __m128i empty, __m128i wrap) {
+	__m128i pro = _mm_and_si128(empty, wrap);
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_srli_epi64(gen, Shift)));
+	pro = _mm_and_si128(pro, _mm_srli_epi64(pro, Shift));
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_srli_epi64(gen, 2 * Shift)));
+	pro = _mm_and_si128(pro, _mm_srli_epi64(pro, 2 * Shift));
+	gen = _mm_or_si128(gen, _mm_and_si128(pro, _mm_srli_epi64(gen, 4 * Shift)));
+	return _mm_and_si128(_mm_srli_epi64(gen, Shift), wrap);
+}
+
+static void slidingAttackMapsSse2Impl(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]) {
+	// Lane 0 is white and lane 1 is black
+	__m128i straight = _mm_set_epi64x((long long)straightSliders[1], (long long)straightSliders[0]);
+	__m128i diagonal = _mm_set_epi64x((long long)diagonalSliders[1], (long long)diagonalSliders[0]);
+	__m128i empty = _mm_set1_epi64x((long long)~occupied);
+	__m128i all = _mm_set1_epi64x(-1);
+	__m128i notFileA = _mm_set1_epi64x((long long)NOT_FILE_A);
+	__m128i notFileH = _mm_set1_epi64x((long long)NOT_FILE_H);
+
+	__m128i result = _mm_or_si128(fillLeftSse2<1>(straight, empty, notFileA), fillRightSse2<1>(straight, empty, notFileH));
+	result = _mm_or_si128(result, _mm_or_si128(fillLeftSse2<8>(straight, empty, all), fillRightSse2<8>(straight, empty, all)));
+	result = _mm_or_si128(result, _mm_or_si128(fillLeftSse2<9>(diagonal, empty, notFileA), fillRightSse2<9>(diagonal, empty, notFileH)));
+	result = _mm_or_si128(result, _mm_or_si128(fillLeftSse2<7>(diagonal, empty, notFileH), fillRightSse2<7>(diagonal, empty, notFileA)));
+
+	_mm_storeu_si128((__m128i *)attacks, result);
+}
+
+// AVX2 shifts each lane by its own count, so each vector holds two directions for both colors
+__attribute__((target("avx2")))
+static __m256i fillLeftAvx2(__m256i gen, __m256i empty, __m256i shift, __m256i wrap) {
+	__m256i shift2 = _mm256_add_epi64(shift, shift);
+	__m256i shift4 = _mm256_add_epi64(shift2, shift2);
+
+	__m256i pro = _mm256_and_si256(empty, wrap);
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift)));
+	pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift2)));
+	pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift2));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift4)));
+	return _mm256_and_si256(_mm256_sllv_epi64(gen, shift), wrap);
+}
+
+__attribute__((target("avx2")))
+static __m256i fillRightAvx2(__m256i gen, __m256i empty, __m256i shift, __m256i wrap) {
+	__m256i shift2 = _mm256_add_epi64(shift, shift);
+	__m256i shift4 = _mm256_add_epi64(shift2, shift2);
+
+	__m256i pro = _mm256_and_si256(empty, wrap);
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift)));
+	pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift2)));
+	pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift2));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift4)));
+	return _mm256_and_si256(_mm256_srlv_epi64(gen, shift), wrap);
+}
+
+__attribute__((target("avx2")))
+static void slidingAttackMapsAvx2Impl(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]) {
+	// Lanes 0 and 1 are the straight sliders of white and black, lanes 2 and 3 their diagonal sliders
+	// _mm256_set_epi64x takes the lanes from 3 down to 0
+	__m256i gen = _mm256_set_epi64x((long long)diagonalSliders[1], (long long)diagonalSliders[0], (long long)straightSliders[1], (long long)straightSliders[0]);
+	__m256i empty = _mm256_set1_epi64x((long long)~occupied);
+
+	__m256i notFileA = _mm256_set1_epi64x((long long)NOT_FILE_A);
+	__m256i notFileH = _mm256_set1_epi64x((long long)NOT_FILE_H);
+	__m256i wrapDownLeft = _mm256_set_epi64x((long long)NOT_FILE_H, (long long)NOT_FILE_H, -1, -1);
+	__m256i wrapUpRight = _mm256_set_epi64x((long long)NOT_FILE_A, (long long)NOT_FILE_A, -1, -1);
+
+	// Straight lanes go one column or one row, diagonal lanes along the diagonal with the same column change
+	__m256i columnShifts = _mm256_set_epi64x(9, 9, 1, 1);
+	__m256i rowShifts = _mm256_set_epi64x(7, 7, 8, 8);
+
+	__m256i result = _mm256_or_si256(fillLeftAvx2(gen, empty, columnShifts, notFileA), fillRightAvx2(gen, empty, columnShifts, notFileH));
+	result = _mm256_or_si256(result, fillLeftAvx2(gen, empty, rowShifts, wrapDownLeft));
+	result = _mm256_or_si256(result, fillRightAvx2(gen, empty, rowShifts, wrapUpRight));
+
+	Bitboard lanes[4];
+	_mm256_storeu_si256((__m256i *)lanes, result);
+	attacks[0] = lanes[0] | lanes[2];
+	attacks[1] = lanes[1] | lanes[3];
+}
+
+const SlidingAttackMapsFunction slidingAttackMapsSse2 = slidingAttackMapsSse2Impl;
+const SlidingAttackMapsFunction slidingAttackMapsAvx2 = slidingAttackMapsAvx2Impl;
+
+bool hasAvx2() {
+	return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+const SlidingAttackMapsFunction slidingAttackMapsSse2 = nullptr;
+const SlidingAttackMapsFunction slidingAttackMapsAvx2 = nullptr;
+
+bool hasAvx2() {
+	return false;
+}
+
+#endif
+
+static SlidingAttackMapsFunction pickSlidingAttackMaps() {
+#ifdef KOGGESTONE_X86
+	return hasAvx2() ? slidingAttackMapsAvx2Impl : slidingAttackMapsSse2Impl;
+#else
+	return slidingAttackMapsScalar;
+#endif
+}
+
+void slidingAttackMaps(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]) {
+	static const SlidingAttackMapsFunction best = pickSlidingAttackMaps();
+	best(diagonalSliders, straightSliders, occupied, attacks);
+}
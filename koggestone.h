@@ -0,0 +1,25 @@
+#ifndef _HEADER_KOGGESTONE_H_
+#define _HEADER_KOGGESTONE_H_
+
+#include "bitboard.h"
+
+// Kogge-Stone fills compute the attacks of every slider of a color at once, one direction at a time
+// Each fill spreads the sliders along a direction in three shifts of 1, 2 and 4 steps, stopping at the first
+// occupied tile, so a whole attack map costs the same however many sliders there are
+// This suits "every tile attacked by a color" queries, magic lookups are faster for a single slider
+
+// The tiles attacked by the diagonal and straight sliders of each color, index by ColorType
+// diagonalSliders are the bishops and queens, straightSliders the rooks and queens
+typedef void (*SlidingAttackMapsFunction)(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]);
+
+// The portable version and the SSE2 and AVX2 versions, which fill several directions or colors per instruction
+// The SIMD versions are only built for x86, where they are null otherwise, AVX2 may only be called when hasAvx2() is true
+void slidingAttackMapsScalar(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]);
+extern const SlidingAttackMapsFunction slidingAttackMapsSse2;
+extern const SlidingAttackMapsFunction slidingAttackMapsAvx2;
+bool hasAvx2();
+
+// The fastest version this CPU runs, picked on first use
+void slidingAttackMaps(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]);
+
+#endif // !_HEADER_KOGGESTONE_H_
@@ -0,0 +1,167 @@
+#include "magic.h"
+
+SliderBackend sliderBackend = SliderBackend::MAGIC;
+
+Magic bishopMagics[64];
+Magic rookMagics[64];
+
+Bitboard betweenBB[64][64];
+Bitboard lineBB[64][64];
+
+// Every blocker subset of every square, 5248 for bishops and 102400 for rooks
+Bitboard bishopTable[5248];
+Bitboard rookTable[102400];
+
+// xorshift64* generator with a fixed seed so the same magics are found on every run
+class MagicRandom {
+	Bitboard state;
+
+	public:
+		MagicRandom(Bitboard seed) : state{ seed } {}
+		Bitboard next() {
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 2685821657736338717ULL;
+		}
+		// Magics with few set bits are found much faster
+		Bitboard sparse() {
+			return next() & next() & next();
+		}
+};
+
+// Finds a magic for every square of one slider type and fills its attack table
+void initSliderMagics(Magic magics[64], Bitboard *table, Bitboard (*rayAttacks)(int, Bitboard)) {
+	Bitboard occupancies[4096];
+	Bitboard references[4096];
+	int epochs[4096] = {};
+	int epoch = 0;
+
+	MagicRandom random = MagicRandom(728ULL);
+	Bitboard *nextTable = table;
+
+	for (int square = 0; square < 64; square++) {
+		Magic &m = magics[square];
+
+		// Tiles on the edge of the board never block anything behind them so they are left out of the mask
+		int x = squareX(square);
+		int y = squareY(square);
+		Bitboard edges = ((rowBB(0) | rowBB(7)) & ~rowBB(y)) | ((FILE_A_BB | FILE_H_BB) & ~(FILE_A_BB << x));
+
+		m.mask = rayAttacks(square, EMPTY_BB) & ~edges;
+		m.shift = 64 - popCount(m.mask);
+		m.attacks = nextTable;
+
+		// Enumerate every subset of the mask with the Carry-Rippler trick
+		int size = 0;
+		Bitboard subset = EMPTY_BB;
+		do {
+			occupancies[size] = subset;
+			references[size] = rayAttacks(square, subset);
+			size++;
+			subset = (subset - m.mask) & m.mask;
+		} while (subset);
+
+		nextTable += size;
+
+		// Try random magics until every subset maps to a slot without a conflicting attack set
+		bool found = false;
+		while (!found) {
+			m.magic = random.sparse();
+			if (popCount((m.mask * m.magic) >> 56) < 6) {
+				continue;
+			}
+
+			epoch++;
+			found = true;
+			for (int i = 0; i < size; i++) {
+				unsigned int index = m.magicIndex(occupancies[i]);
+
+				if (epochs[index] < epoch) {
+					epochs[index] = epoch;
+					m.attacks[index] = references[i];
+				} else if (m.attacks[index] != references[i]) {
+					found = false;
+					break;
+				}
+			}
+		}
+	}
+}
+
+// Refills the attack table of every square in the order the backend indexes it
+// Both backends give a square as many slots as its mask has subsets, so the tables stay where they are
+void fillSliderAttacks(Magic magics[64], Bitboard (*rayAttacks)(int, Bitboard), SliderBackend backend) {
+	for (int square = 0; square < 64; square++) {
+		Magic &m = magics[square];
+
+		Bitboard subset = EMPTY_BB;
+		do {
+			unsigned int index = (backend == SliderBackend::PEXT) ? m.index<SliderBackend::PEXT>(subset) : m.index<SliderBackend::MAGIC>(subset);
+			m.attacks[index] = rayAttacks(square, subset);
+			subset = (subset - m.mask) & m.mask;
+		} while (subset);
+	}
+}
+
+bool hasPext() {
+#ifdef MAGIC_PEXT
+	return __builtin_cpu_supports("bmi2");
+#else
+	return false;
+#endif
+}
+
+bool hasFastPext() {
+#ifdef MAGIC_PEXT
+	return hasPext() && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+#else
+	return false;
+#endif
+}
+
+bool setSliderBackend(SliderBackend backend) {
+	if (backend == SliderBackend::PEXT && !hasPext()) {
+		return false;
+	}
+
+	fillSliderAttacks(bishopMagics, bishopRayAttacks, backend);
+	fillSliderAttacks(rookMagics, rookRayAttacks, backend);
+	sliderBackend = backend;
+	return true;
+}
+
+const char *sliderBackendName(SliderBackend backend) {
+	switch (backend) {
+		case SliderBackend::PEXT:
+			return "pext";
+		default:
+			return "magic";
+	}
+}
+
+void initMagics() {
+	initSliderMagics(bishopMagics, bishopTable, bishopRayAttacks);
+	initSliderMagics(rookMagics, rookTable, rookRayAttacks);
+
+	sliderBackend = SliderBackend::MAGIC;
+	if (hasFastPext()) {
+		setSliderBackend(SliderBackend::PEXT);
+	}
+
+	for (int from = 0; from < 64; from++) {
+		for (int to = 0; to < 64; to++) {
+			betweenBB[from][to] = EMPTY_BB;
+			lineBB[from][to] = EMPTY_BB;
+
+			// A slider standing on either square sees the other one on an empty board
+			Bitboard (*rayFunctions[2])(int, Bitboard) = { bishopRayAttacks, rookRayAttacks };
+			for (int i = 0; i < 2; i++) {
+				if (from != to && (rayFunctions[i](from, EMPTY_BB) & squareBB(to))) {
+					betweenBB[from][to] = rayFunctions[i](from, squareBB(to)) & rayFunctions[i](to, squareBB(from));
+					lineBB[from][to] = (rayFunctions[i](from, EMPTY_BB) & rayFunctions[i](to, EMPTY_BB)) | squareBB(from) | squareBB(to);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#ifndef _HEADER_MAGIC_H_
+#define _HEADER_MAGIC_H_
+
+#include "bitboard.h"
+
+#if defined(__x86_64__)
+#define MAGIC_PEXT
+#endif
+
+// How the blockers of a slider are turned into an index in its attack table
+// MAGIC multiplies them by a magic number and works everywhere, PEXT gathers the mask bits with the BMI2
+// instruction of the same name, which is faster where the CPU implements it in hardware
+enum class SliderBackend { MAGIC, PEXT };
+
+extern SliderBackend sliderBackend;
+
+#ifdef MAGIC_PEXT
+// Written as assembly so the rest of the program does not have to be built for BMI2
+// Only called once the CPU is known to have it
+inline Bitboard pextBits(Bitboard value, Bitboard mask) {
+	Bitboard result;
+	asm("pextq %2, %1, %0" : "=r"(result) : "r"(value), "rm"(mask));
+	return result;
+}
+#endif
+
+// Magic bitboard lookup for the sliding pieces
+// The blockers of a slider, (occupied & mask), are multiplied by a magic number so that their bits
+// land in the top bits of the product. Those bits index a table of precomputed attack sets
+struct Magic {
+	Bitboard mask;
+	Bitboard magic;
+	Bitboard *attacks;
+	int shift;
+
+	unsigned int magicIndex(Bitboard occupied) const {
+		return (unsigned int)(((occupied & mask) * magic) >> shift);
+	}
+
+	// The backend is a template argument so a lookup never tests which one is in use
+	template<SliderBackend Backend>
+	unsigned int index(Bitboard occupied) const;
+};
+
+template<>
+inline unsigned int Magic::index<SliderBackend::MAGIC>(Bitboard occupied) const {
+	return magicIndex(occupied);
+}
+
+// Without PEXT setSliderBackend never picks it, this only keeps the callers free of #ifdefs
+template<>
+inline unsigned int Magic::index<SliderBackend::PEXT>(Bitboard occupied) const {
+#ifdef MAGIC_PEXT
+	return (unsigned int)pextBits(occupied, mask);
+#else
+	return magicIndex(occupied);
+#endif
+}
+
+extern Magic bishopMagics[64];
+extern Magic rookMagics[64];
+
+// For two squares on a common row, column or diagonal, betweenBB holds the tiles strictly between them
+// and lineBB the whole line through both. Both are empty for squares that are not aligned
+extern Bitboard betweenBB[64][64];
+extern Bitboard lineBB[64][64];
+
+// Searches the magic numbers and fills the attack and line tables, this must be called once at startup
+// before any Board is used. The backend is picked from the CPU, PEXT when hasFastPext() is true
+void initMagics();
+
+// Whether the CPU has PEXT at all, and whether it is fast (AMD before Zen 3 runs it in microcode)
+bool hasPext();
+bool hasFastPext();
+
+// Lays the attack tables out for another backend, returns false and keeps the current one if the CPU cannot run it
+bool setSliderBackend(SliderBackend backend);
+const char *sliderBackendName(SliderBackend backend);
+
+// The lookups for one backend, only correct while the tables are laid out for it
+// Callers read sliderBackend once and pass it down as a template argument, see Board::getAllValidColorMoves
+template<SliderBackend Backend>
+inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+	const Magic &m = bishopMagics[square];
+	return m.attacks[m.index<Backend>(occupied)];
+}
+
+template<SliderBackend Backend>
+inline Bitboard rookAttacks(int square, Bitboard occupied) {
+	const Magic &m = rookMagics[square];
+	return m.attacks[m.index<Backend>(occupied)];
+}
+
+template<SliderBackend Backend>
+inline Bitboard queenAttacks(int square, Bitboard occupied) {
+	return bishopAttacks<Backend>(square, occupied) | rookAttacks<Backend>(square, occupied);
+}
+
+#endif // !_HEADER_MAGIC_H_
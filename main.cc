@@ -3,15 +3,64 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <sstream>
 
 #include "move.h"
 #include "board.h"
-#include "piece.h"
 #include "agent.h"
 
 #include "window.h"
+#include "magic.h"
+#include "perft.h"
+#include "bench.h"
+
+// Reads the depth of a perft or divide command, then "-threads N" and "-hash MB" if they follow on the same line
+// False if the depth is missing or not positive, or an option is not followed by a count of at least 1
+bool readPerftArguments(int &depth, int &threads, size_t &hashMegabytes) {
+	std::cin >> depth;
+	if (std::cin.eof() || std::cin.fail() || depth < 1) {
+		std::cin.clear();
+		std::cout << "[PERFT] expected a depth of at least 1" << std::endl;
+		return false;
+	}
+
+	threads = 1;
+	hashMegabytes = 0;
+	std::string rest;
+	std::getline(std::cin, rest);
+	std::istringstream options(rest);
+
+	std::string option;
+	while (options >> option) {
+		if (option == "-threads" && (options >> threads) && threads >= 1) {
+			continue;
+		}
+		int megabytes = 0;
+		if (option == "-hash" && (options >> megabytes) && megabytes >= 1) {
+			hashMegabytes = megabytes;
+			continue;
+		}
+		std::cout << "[PERFT] expected -threads N or -hash MB, each with a count of at least 1" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+
+	// Build the slider attack tables before any board is created
+	initMagics();
 
-int main() {
+	// "chess bench [depth]" runs the bench and exits, so builds can be compared without the game loop
+	if (argc >= 2 && std::string(argv[1]) == "bench") {
+		int depth = (argc >= 3) ? std::atoi(argv[2]) : BENCH_DEFAULT_DEPTH;
+		if (depth < 1) {
+			std::cout << "[BENCH] expected a depth of at least 1" << std::endl;
+			return 1;
+		}
+		runBench(depth);
+		return 0;
+	}
 
 	const char defaultBoard[8][8] = {
 				{'r','n','b','q','k','b','n','r'},
@@ -161,27 +210,13 @@ int main() {
 				std::shared_ptr<Agent> activeAgent = agents[activeAgentId];
 				ColorType currentAgentColor = intToColorType(activeAgentId);
 
-				// Detect checkmate
-				ColorType checkmateColor = ColorType::NONE;
-				if (board.isCheckmate(checkmateColor)) {
-					//std::cout << "[GAMELOOP] CHECKMATE DETECTED V1" << std::endl;
+				// Detect checkmate, stalemate, insuffiant material, repetition and the fifty move rule
+				// The legal moves are generated once here and reused by the agents below
+				MoveList legalMoves;
+				GameState state = board.gameState(legalMoves);
 
-					// Add to game score
-					if (checkmateColor == ColorType::WHITE) {
-						std::cout << "Checkmate! Black wins!" << std::endl;
-						blackScore++;
-					}
-					else if (checkmateColor == ColorType::BLACK) {
-						std::cout << "Checkmate! White wins!" << std::endl;
-						whiteScore++;
-					}
-
-					break;
-				}
-
-				// More detect checkmate
-				if (activeAgent->isCheckmated(board, currentAgentColor)) {
-					//std::cout << "[GAMELOOP] CHECKMATE DETECTED V2" << std::endl;
+				if (state == GameState::CHECKMATE) {
+					//std::cout << "[GAMELOOP] CHECKMATE DETECTED" << std::endl;
 
 					// Add to game score
 					if (currentAgentColor == ColorType::WHITE) {
@@ -193,22 +228,20 @@ int main() {
 					}
 
 					break;
-				}
-
-				// Detect stalemate
-				ColorType stalemateColor = ColorType::NONE;
-				if (board.isStalemate(stalemateColor)) {
+				} else if (state == GameState::STALEMATE) {
 					//std::cout << "[GAMELOOP] STALEMATE DETECTED" << std::endl;
 					std::cout << "Stalemate!" << std::endl;
 					break;
-				}
-
-				// Detect insuffiant material
-				ColorType noMatColor = ColorType::NONE;
-				if (board.isInsuffiantMaterial(noMatColor)) {
+				} else if (state == GameState::INSUFFICIENT_MATERIAL) {
 					//std::cout << "[GAMELOOP] INSUFFIANT MATERIAL" << std::endl;
 					std::cout << "Insufficient Material!" << std::endl;
 					break;
+				} else if (state == GameState::THREEFOLD_REPETITION) {
+					std::cout << "Draw by threefold repetition!" << std::endl;
+					break;
+				} else if (state == GameState::FIFTY_MOVES) {
+					std::cout << "Draw by the fifty move rule!" << std::endl;
+					break;
 				}
 
 				// Print check alerts
@@ -238,7 +271,7 @@ int main() {
 
 					// The command move is needed for the computer
 					if (activeAgent->getType() == AgentType::BOT) {
-						Move selectedMove = activeAgent->getMove(board, currentAgentColor);
+						Move selectedMove = activeAgent->getMove(board, currentAgentColor, legalMoves);
 #if false
 						// TMP
 						if (selectedMove.getMoveType() == MoveType::EN_PASSANT) {
@@ -258,7 +291,7 @@ int main() {
 						// If not a valid move, do not advance the game
 						// Instead the loop will prompt the player for a new command
 
-						std::vector<Move> possibleMoves = board.getAllValidColorMoves(currentAgentColor, false);
+						MoveList &possibleMoves = legalMoves;
 
 						// Read in human commands
 						std::string arg1;
@@ -296,10 +329,10 @@ int main() {
 								// Check if positionArg1 and positionArg2 match the from and destination of a move
 								// if not, it might be castling
 								bool foundMoves = false;
-								std::vector<Move> selectedMoves;
+								MoveList selectedMoves;
 
 								bool hasCastlingMoves = false;
-								std::vector<Move> castlingMoves;
+								MoveList castlingMoves;
 
 								for (Move &mv : possibleMoves) {
 
@@ -405,6 +438,18 @@ int main() {
 				} else if (gameCommand == "undo") {
 					std::cout << "[GAMELOOP] UNDO" << std::endl;
 					board.undoLastMove();
+				} else if (gameCommand == "perft" || gameCommand == "divide") {
+					// Count from the position on the board, every move is undone so the game carries on unchanged
+					int depth = 0;
+					int threads = 1;
+					size_t hashMegabytes = 0;
+					if (readPerftArguments(depth, threads, hashMegabytes)) {
+						if (gameCommand == "perft") {
+							printPerft(board, depth, threads, hashMegabytes);
+						} else {
+							printDivide(board, depth, threads, hashMegabytes);
+						}
+					}
 				} else {
 					std::cout << "[GAMELOOP] unknown command" << std::endl;
 				}
@@ -526,6 +571,30 @@ int main() {
 				drawBoard.drawChars();
 			}
 
+		} else if (command == "perft" || command == "divide") {
+			// Count from the setup board when one was accepted, otherwise from the starting position
+			int depth = 0;
+			int threads = 1;
+			size_t hashMegabytes = 0;
+			if (readPerftArguments(depth, threads, hashMegabytes)) {
+				char boardToUse[8][8];
+				for (int row = 0; row < 8; row++) {
+					for (int col = 0; col < 8; col++) {
+						boardToUse[row][col] = useSetupBoard ? setupBoard[row][col] : defaultBoard[row][col];
+					}
+				}
+
+				Board board = Board(boardToUse);
+				board.setTurnNumber(useSetupBoard ? setupTurn : 0);
+
+				if (command == "perft") {
+					printPerft(board, depth, threads, hashMegabytes);
+				} else {
+					printDivide(board, depth, threads, hashMegabytes);
+				}
+			}
+		} else if (command == "bench") {
+			runBench();
 		} else if (command == "quit") {
 			std::cout << "[MAINLOOP] exiting program" << std::endl;
 			break;
@@ -1,66 +1,119 @@
 #ifndef _HEADER_MOVE_H_
 #define _HEADER_MOVE_H_
 
-#include <memory>
+#include <utility>
 
-#include "piece.h"
+#include "piececode.h"
 
 class Board;
-class Piece;
-enum class ColorType;
-enum class PieceType;
 
 enum class MoveType { CAPTURE, MOVE, CASTLE_KING, CASTLE_QUEEN, EN_PASSANT, PAWN_BIGMOVE, NONE, PROMOTE };
 
+// A move is packed into 32 bits, which keeps move lists and the move history small
+//   bits 0-5    from square
+//   bits 6-11   destination square
+//   bits 12-14  MoveType
+//   bits 15-18  PieceCode of the moving piece
+//   bits 19-22  PieceCode of the captured piece
+//   bits 23-25  PieceType to promote to
+// The capture position is not stored, it follows from the move type (see getCaptureSquare)
 class Move {
-	MoveType mType;
+	unsigned int data;
 
-	// Data about the from piece
-	std::pair<int, int> fromPosition;
-	ColorType fromColor;
-	PieceType fromPiece;
+	static const int FROM_SHIFT = 0;
+	static const int DESTINATION_SHIFT = 6;
+	static const int TYPE_SHIFT = 12;
+	static const int FROM_PIECE_SHIFT = 15;
+	static const int CAPTURE_PIECE_SHIFT = 19;
+	static const int PROMOTE_SHIFT = 23;
 
-	// Data about the destination piece
-	std::pair<int, int> destinationPosition;
-	ColorType destinationColor;
-	PieceType destinationPiece;
+	unsigned int field(int shift, unsigned int mask) const {
+		return (data >> shift) & mask;
+	}
 
-	// Data about the capture piece
-	std::pair<int, int> capturePosition;
-	ColorType captureColor;
-	PieceType capturePiece;
+	public:
+		// An empty move, only used to fill storage such as a MoveList before it is assigned
+		Move() = default;
+		// Builds a move from squares, fromCode is the moving piece and captureCode the piece it takes
+		Move(MoveType mt, int fromSquare, int destinationSquare, PieceCode fromCode, PieceCode captureCode, PieceType promote = PieceType::PAWN) :
+			data{ ((unsigned int)fromSquare << FROM_SHIFT) | ((unsigned int)destinationSquare << DESTINATION_SHIFT) |
+				((unsigned int)mt << TYPE_SHIFT) | ((unsigned int)fromCode << FROM_PIECE_SHIFT) |
+				((unsigned int)captureCode << CAPTURE_PIECE_SHIFT) | ((unsigned int)promote << PROMOTE_SHIFT) } {}
+		// The pieces involved are read from the board at the given positions
+		// The capture position must be the one implied by the move type
+		Move(MoveType mt, Board &brd, std::pair<int, int> from, std::pair<int, int> destination, std::pair<int, int> capture, PieceType promote = (PieceType)0); // (PieceType)0 is pawn
 
-	// Data about the promotion (if applicable)
-	PieceType promotePiece;
-	ColorType promoteColor;
+		MoveType getMoveType() const {
+			return (MoveType)field(TYPE_SHIFT, 7);
+		}
+		int getFromSquare() const {
+			return field(FROM_SHIFT, 63);
+		}
+		int getDestinationSquare() const {
+			return field(DESTINATION_SHIFT, 63);
+		}
+		// Where the captured piece stands, for castling this is where the king lands (the rook lands on the destination)
+		int getCaptureSquare() const {
+			int destination = getDestinationSquare();
+			switch (getMoveType()) {
+				case MoveType::CASTLE_KING:
+					return destination + 1;
+				case MoveType::CASTLE_QUEEN:
+					return destination - 1;
+				case MoveType::EN_PASSANT:
+					// The captured pawn is beside the from square, on the destination's column
+					return (getFromSquare() & ~7) | (destination & 7);
+				default:
+					return destination;
+			}
+		}
+
+		std::pair<int, int> getFromPosition() const {
+			return std::pair<int, int>(getFromSquare() & 7, getFromSquare() >> 3);
+		}
+		std::pair<int, int> getDestinationPosition() const {
+			return std::pair<int, int>(getDestinationSquare() & 7, getDestinationSquare() >> 3);
+		}
+		std::pair<int, int> getCapturePosition() const {
+			return std::pair<int, int>(getCaptureSquare() & 7, getCaptureSquare() >> 3);
+		}
+
+		// Returns the PieceCode of the piece that was captured, it is put back on undo
+		PieceCode getCapturePieceCode() const {
+			return (PieceCode)field(CAPTURE_PIECE_SHIFT, 15);
+		}
+		PieceCode getFromPieceCode() const {
+			return (PieceCode)field(FROM_PIECE_SHIFT, 15);
+		}
 
-	public:
-		MoveType getMoveType();
-		std::pair<int, int> getFromPosition();
-		std::pair<int, int> getDestinationPosition();
-		std::pair<int, int> getCapturePosition();
-		Move(MoveType mt, std::shared_ptr<Piece> from, std::shared_ptr<Piece> destination, std::shared_ptr<Piece> capture, PieceType promote = (PieceType)0); // (PieceType)0 is pawn
-
-		// Returns a shared_ptr to a Piece that was previously captured
-		std::shared_ptr<Piece> recreateCapturedPiece();
-		
 		// Determines if a move puts the king in check or not
-		bool isChecking();
+		bool isChecking() const {
+			// All moves that attack a king have a capture piece of type king
+			return getCapturePieceType() == PieceType::KING;
+		}
 
 		// Information about the capture, from, promotion
-		PieceType getCapturePieceType() {
-			return capturePiece;
+		PieceType getCapturePieceType() const {
+			return pieceTypeOf(getCapturePieceCode());
 		}
-		PieceType getFromPieceType() {
-			return fromPiece;
+		PieceType getFromPieceType() const {
+			return pieceTypeOf(getFromPieceCode());
 		}
-		ColorType getFromPieceColor() {
-			return fromColor;
+		ColorType getFromPieceColor() const {
+			return colorOf(getFromPieceCode());
 		}
-		PieceType getPromoteType() {
-			return promotePiece;
+		PieceType getPromoteType() const {
+			return (PieceType)field(PROMOTE_SHIFT, 7);
 		}
 
+		bool operator==(const Move &other) const {
+			return data == other.data;
+		}
+		bool operator!=(const Move &other) const {
+			return data != other.data;
+		}
 };
 
+static_assert(sizeof(Move) == 4, "a Move must fit in 32 bits");
+
 #endif // !_HEADER_MOVE_H_
@@ -0,0 +1,55 @@
+#ifndef _HEADER_MOVELIST_H_
+#define _HEADER_MOVELIST_H_
+
+#include <cassert>
+
+#include "move.h"
+
+// A game never has more than 218 legal moves, but set up mode accepts any number of pieces, so the
+// capacity is the most pseudo legal moves any board can have. Pieces reach a tile from at most 8 rays,
+// where only the nearest piece can move in, and from at most 8 knight squares: 16 moves onto each of
+// 64 tiles. At most 3 pawns move onto each of the 8 promotion tiles, each adding 3 more promotions,
+// and there are 2 castling moves
+const int MAX_MOVES = 16 * 64 + 3 * 3 * 8 + 2;
+
+// A list of moves stored inline, so filling one never allocates
+// Generators append into a MoveList passed by reference instead of returning a vector
+class MoveList {
+	Move moves[MAX_MOVES];
+	int count = 0;
+
+	public:
+		void push_back(const Move &mv) {
+			assert(count < MAX_MOVES);
+			moves[count++] = mv;
+		}
+		void clear() {
+			count = 0;
+		}
+		int size() const {
+			return count;
+		}
+		bool empty() const {
+			return count == 0;
+		}
+		Move &operator[](int index) {
+			return moves[index];
+		}
+		const Move &operator[](int index) const {
+			return moves[index];
+		}
+		Move *begin() {
+			return moves;
+		}
+		Move *end() {
+			return moves + count;
+		}
+		const Move *begin() const {
+			return moves;
+		}
+		const Move *end() const {
+			return moves + count;
+		}
+};
+
+#endif // !_HEADER_MOVELIST_H_
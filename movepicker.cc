@@ -0,0 +1,254 @@
+#include "movepicker.h"
+
+// getPiecePoints() values the king at nothing, in an exchange it is worth more than anything it could take
+static int exchangeValue(PieceType pt) {
+	return (pt == PieceType::KING) ? 100 : getPiecePoints(pt);
+}
+
+// staticExchange for one backend, so the x-ray lookups in the loop do not test which one is in use
+template<SliderBackend Backend>
+static int staticExchangeWith(Board &brd, Move &mv) {
+	int toSquare = mv.getDestinationSquare();
+
+	Bitboard diagonalSliders = EMPTY_BB;
+	Bitboard straightSliders = EMPTY_BB;
+	for (ColorType ct : { ColorType::WHITE, ColorType::BLACK }) {
+		diagonalSliders |= brd.getPieces(ct, PieceType::BISHOP) | brd.getPieces(ct, PieceType::QUEEN);
+		straightSliders |= brd.getPieces(ct, PieceType::ROOK) | brd.getPieces(ct, PieceType::QUEEN);
+	}
+
+	// The pawn taken en passant is not on the destination, take it off the board straight away
+	Bitboard occupied = brd.getOccupied() & ~squareBB(mv.getCaptureSquare());
+	Bitboard attackers = brd.getAttackersTo(toSquare, occupied);
+
+	// gain[i] is what the side making capture i has won if the exchange stops after it
+	// Every capture takes a piece off the board, so a setup board with every tile filled still fits
+	int gain[65];
+	int depth = 0;
+	gain[0] = exchangeValue(mv.getCapturePieceType());
+
+	ColorType side = mv.getFromPieceColor();
+	PieceType attackerType = mv.getFromPieceType();
+	Bitboard attackerBB = squareBB(mv.getFromSquare());
+
+	while (attackerBB) {
+		depth++;
+		gain[depth] = exchangeValue(attackerType) - gain[depth - 1];
+
+		// Neither side can come out ahead by carrying on
+		if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+			break;
+		}
+
+		// Lift the attacker, which may uncover a slider behind it
+		occupied ^= attackerBB;
+		attackers ^= attackerBB;
+		attackers |= ((bishopAttacks<Backend>(toSquare, occupied) & diagonalSliders) | (rookAttacks<Backend>(toSquare, occupied) & straightSliders)) & occupied;
+
+		// The other side recaptures with its cheapest piece
+		side = oppositeColor(side);
+		attackerBB = EMPTY_BB;
+		for (int pt = (int)PieceType::PAWN; pt <= (int)PieceType::KING; pt++) {
+			Bitboard candidates = attackers & brd.getPieces(side, (PieceType)pt);
+			if (candidates) {
+				attackerBB = candidates & (~candidates + 1);
+				attackerType = (PieceType)pt;
+				break;
+			}
+		}
+	}
+
+	// Each side only takes back if it is worth it, unwind from the last capture
+	while (--depth) {
+		gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+	}
+
+	return gain[0];
+}
+
+int staticExchange(Board &brd, Move &mv) {
+	if (sliderBackend == SliderBackend::PEXT) {
+		return staticExchangeWith<SliderBackend::PEXT>(brd, mv);
+	}
+	return staticExchangeWith<SliderBackend::MAGIC>(brd, mv);
+}
+
+MovePicker::MovePicker(Board &brd, ColorType ct, const Move *hashMove, const Move *killers, int killerCount) :
+	board{ brd }, color{ ct }, hasHashMove{ false }, killerCount{ 0 }, stage{ Stage::HASH_MOVE }, index{ 0 }, losingIndex{ 0 } {
+
+	// A hash move can come from another position with the same key, only keep it if it is legal here
+	if (hashMove != nullptr) {
+		MoveList pieceMoves;
+		board.getValidColorMoves(color, pieceMoves, MoveGenType::ALL, squareBB(hashMove->getFromSquare()));
+
+		for (Move &mv : pieceMoves) {
+			if (mv == *hashMove) {
+				this->hashMove = mv;
+				hasHashMove = true;
+				break;
+			}
+		}
+	}
+
+	if (killers != nullptr) {
+		for (int i = 0; i < killerCount && i < MAX_KILLERS; i++) {
+			this->killers[this->killerCount++] = killers[i];
+		}
+	}
+}
+
+bool MovePicker::isLegalKiller(Move &killer) {
+	// Only the moves of the killer's piece are generated, the other quiet moves wait for their stage
+	MoveList pieceMoves;
+	board.getValidColorMoves(color, pieceMoves, MoveGenType::QUIETS, squareBB(killer.getFromSquare()));
+
+	for (Move &mv : pieceMoves) {
+		if (mv == killer) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MovePicker::isHandedOut(Move &mv) {
+	if (hasHashMove && mv == hashMove) {
+		return true;
+	}
+
+	// Killers are handed out from the quiet moves, before the others
+	if (stage == Stage::QUIETS) {
+		for (int i = 0; i < killerCount; i++) {
+			if (mv == killers[i]) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void MovePicker::selectBest() {
+	int bestIndex = index;
+	for (int i = index + 1; i < moves.size(); i++) {
+		if (scores[i] > scores[bestIndex]) {
+			bestIndex = i;
+		}
+	}
+
+	std::swap(moves[index], moves[bestIndex]);
+	std::swap(scores[index], scores[bestIndex]);
+}
+
+void MovePicker::enterStage(Stage nextStage) {
+	stage = nextStage;
+	index = 0;
+
+	switch (nextStage) {
+		case Stage::WINNING_CAPTURES:
+			// Most valuable victim first, cheapest attacker first among equal victims
+			moves.clear();
+			board.getValidColorMoves(color, moves, MoveGenType::CAPTURES);
+			for (int i = 0; i < moves.size(); i++) {
+				scores[i] = exchangeValue(moves[i].getCapturePieceType()) * 128 - exchangeValue(moves[i].getFromPieceType());
+			}
+			break;
+		case Stage::PROMOTIONS:
+			// Queens first, a capture on the way breaks ties
+			moves.clear();
+			board.getValidColorMoves(color, moves, MoveGenType::PROMOTIONS);
+			for (int i = 0; i < moves.size(); i++) {
+				scores[i] = exchangeValue(moves[i].getPromoteType()) * 128 + exchangeValue(moves[i].getCapturePieceType());
+			}
+			break;
+		case Stage::QUIETS:
+			moves.clear();
+			board.getValidColorMoves(color, moves, MoveGenType::QUIETS);
+			break;
+		default:
+			break;
+	}
+}
+
+bool MovePicker::next(Move &mv) {
+	while (true) {
+		switch (stage) {
+			case Stage::HASH_MOVE:
+				enterStage(Stage::WINNING_CAPTURES);
+				if (hasHashMove) {
+					mv = hashMove;
+					return true;
+				}
+				break;
+
+			case Stage::WINNING_CAPTURES:
+				while (index < moves.size()) {
+					selectBest();
+					Move candidate = moves[index++];
+
+					if (isHandedOut(candidate)) {
+						continue;
+					}
+					if (staticExchange(board, candidate) < 0) {
+						losingCaptures.push_back(candidate);
+						continue;
+					}
+
+					mv = candidate;
+					return true;
+				}
+				enterStage(Stage::PROMOTIONS);
+				break;
+
+			case Stage::PROMOTIONS:
+				while (index < moves.size()) {
+					selectBest();
+					Move candidate = moves[index++];
+
+					if (!isHandedOut(candidate)) {
+						mv = candidate;
+						return true;
+					}
+				}
+				enterStage(Stage::KILLERS);
+				break;
+
+			case Stage::KILLERS:
+				while (index < killerCount) {
+					Move killer = killers[index++];
+					if ((hasHashMove && killer == hashMove) || (index == 2 && killer == killers[0])) {
+						continue;
+					}
+
+					if (isLegalKiller(killer)) {
+						mv = killer;
+						return true;
+					}
+				}
+				enterStage(Stage::QUIETS);
+				break;
+
+			case Stage::QUIETS:
+				while (index < moves.size()) {
+					Move candidate = moves[index++];
+
+					if (!isHandedOut(candidate)) {
+						mv = candidate;
+						return true;
+					}
+				}
+				enterStage(Stage::LOSING_CAPTURES);
+				break;
+
+			case Stage::LOSING_CAPTURES:
+				if (losingIndex < losingCaptures.size()) {
+					mv = losingCaptures[losingIndex++];
+					return true;
+				}
+				stage = Stage::DONE;
+				break;
+
+			case Stage::DONE:
+				return false;
+		}
+	}
+}
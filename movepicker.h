@@ -0,0 +1,66 @@
+#ifndef _HEADER_MOVEPICKER_H_
+#define _HEADER_MOVEPICKER_H_
+
+#include <algorithm>
+
+#include "piececode.h"
+#include "move.h"
+#include "movelist.h"
+#include "board.h"
+
+class Board;
+
+// The material won or lost by the side making the capture mv once every piece able to recapture on
+// its destination has done so, cheapest piece first (static exchange evaluation)
+// Counted in getPiecePoints() units, 0 for an even trade
+int staticExchange(Board &brd, Move &mv);
+
+// Hands out the legal moves of a position one at a time in the order a search wants to try them:
+// the hash move, winning captures, promotions, killer moves, quiet moves, then losing captures
+// Each stage is only generated once the previous one has run out, so a search that cuts off after the
+// first few moves never pays for generating the rest
+class MovePicker {
+	enum class Stage { HASH_MOVE, WINNING_CAPTURES, PROMOTIONS, KILLERS, QUIETS, LOSING_CAPTURES, DONE };
+
+	Board &board;
+	ColorType color;
+
+	Move hashMove;
+	bool hasHashMove;
+
+	static const int MAX_KILLERS = 2;
+	Move killers[MAX_KILLERS];
+	int killerCount;
+
+	Stage stage;
+
+	// The moves of the current stage and their ordering scores, index is the next one to hand out
+	MoveList moves;
+	int scores[MAX_MOVES];
+	int index;
+
+	// Captures that lose material are put aside until everything else has been tried
+	MoveList losingCaptures;
+	int losingIndex;
+
+	// Whether the killer is a legal quiet move in this position
+	bool isLegalKiller(Move &killer);
+
+	// Moves already handed out by an earlier stage
+	bool isHandedOut(Move &mv);
+
+	// Swaps the highest scored move left into moves[index]
+	void selectBest();
+
+	// Generates the moves of the stage and moves on to it
+	void enterStage(Stage nextStage);
+
+	public:
+		// hashMove and killers may be null, they are only handed out if they are legal in this position
+		MovePicker(Board &brd, ColorType ct, const Move *hashMove = nullptr, const Move *killers = nullptr, int killerCount = 0);
+
+		// Puts the next move in mv, returns false once every legal move has been handed out
+		bool next(Move &mv);
+};
+
+#endif // !_HEADER_MOVEPICKER_H_
@@ -0,0 +1,309 @@
+#include "perft.h"
+
+unsigned long long perft(Board &brd, int depth, bool bulkCounting) {
+	if (depth <= 0) {
+		return 1;
+	}
+
+	MoveList moves;
+	brd.getAllValidColorMoves(intToColorType(brd.getTurnNumber()), moves, false);
+
+	if (bulkCounting && depth == 1) {
+		return moves.size();
+	}
+
+	unsigned long long nodes = 0;
+	for (Move &mv : moves) {
+		brd.enactMove(mv);
+		nodes += perft(brd, depth - 1, bulkCounting);
+		brd.undoLastMove();
+	}
+
+	return nodes;
+}
+
+PerftTable::PerftTable(size_t megabytes) : entryCount{ 1 }, probes{ 0 }, hits{ 0 } {
+	size_t maxEntries = std::min(megabytes, PERFT_MAX_HASH_MEGABYTES) * 1024 * 1024 / sizeof(Entry);
+	while (entryCount * 2 <= maxEntries) {
+		entryCount *= 2;
+	}
+
+	// A -hash bigger than the memory left would otherwise end the program with std::bad_alloc
+	entries.reset(new (std::nothrow) Entry[entryCount]);
+	while (!entries && entryCount > 1) {
+		entryCount /= 2;
+		entries.reset(new (std::nothrow) Entry[entryCount]);
+	}
+	if (!entries) {
+		throw std::bad_alloc();
+	}
+	clear();
+}
+
+bool PerftTable::probe(ZobristKey key, int depth, unsigned long long &nodes) const {
+	const Entry &entry = entries[key & (entryCount - 1)];
+	unsigned long long data = entry.data.load(std::memory_order_relaxed);
+	unsigned long long check = entry.check.load(std::memory_order_relaxed);
+
+	if ((check ^ data) != key || (int)(data & 0xFF) != depth) {
+		return false;
+	}
+
+	nodes = data >> 8;
+	return true;
+}
+
+void PerftTable::store(ZobristKey key, int depth, unsigned long long nodes) {
+	Entry &entry = entries[key & (entryCount - 1)];
+	unsigned long long data = (nodes << 8) | (unsigned long long)depth;
+
+	entry.check.store(key ^ data, std::memory_order_relaxed);
+	entry.data.store(data, std::memory_order_relaxed);
+}
+
+void PerftTable::clear() {
+	for (size_t i = 0; i < entryCount; i++) {
+		entries[i].check.store(0, std::memory_order_relaxed);
+		entries[i].data.store(0, std::memory_order_relaxed);
+	}
+	probes = 0;
+	hits = 0;
+}
+
+void PerftTable::addStats(unsigned long long searchProbes, unsigned long long searchHits) {
+	probes += searchProbes;
+	hits += searchHits;
+}
+
+unsigned long long PerftTable::getProbes() const {
+	return probes;
+}
+
+unsigned long long PerftTable::getHits() const {
+	return hits;
+}
+
+double PerftTable::occupancy() const {
+	size_t used = 0;
+	for (size_t i = 0; i < entryCount; i++) {
+		if (entries[i].data.load(std::memory_order_relaxed) != 0) {
+			used++;
+		}
+	}
+	return (double)used / entryCount;
+}
+
+size_t PerftTable::size() const {
+	return entryCount;
+}
+
+// Depth 1 is a single move generation with bulk counting, cheaper than a probe that misses
+static unsigned long long hashedPerftNode(Board &brd, int depth, PerftTable &table, unsigned long long &probes, unsigned long long &hits) {
+	if (depth <= 1) {
+		return perft(brd, depth);
+	}
+
+	ZobristKey key = brd.hash();
+	unsigned long long nodes = 0;
+
+	probes++;
+	if (table.probe(key, depth, nodes)) {
+		hits++;
+		return nodes;
+	}
+
+	MoveList moves;
+	brd.getAllValidColorMoves(intToColorType(brd.getTurnNumber()), moves, false);
+
+	for (Move &mv : moves) {
+		brd.enactMove(mv);
+		nodes += hashedPerftNode(brd, depth - 1, table, probes, hits);
+		brd.undoLastMove();
+	}
+
+	table.store(key, depth, nodes);
+	return nodes;
+}
+
+unsigned long long hashedPerft(Board &brd, int depth, PerftTable &table) {
+	unsigned long long probes = 0;
+	unsigned long long hits = 0;
+	unsigned long long nodes = hashedPerftNode(brd, depth, table, probes, hits);
+	table.addStats(probes, hits);
+	return nodes;
+}
+
+// A subtree handed to the workers, rootIndex is the root move it belongs to
+struct PerftTask {
+	BoardSnapshot snapshot;
+	int rootIndex;
+	int depth;
+};
+
+unsigned long long parallelPerft(Board &brd, int depth, int threads, std::vector<unsigned long long> *rootCounts, PerftTable *table) {
+	MoveList rootMoves;
+	brd.getAllValidColorMoves(intToColorType(brd.getTurnNumber()), rootMoves, false);
+
+	if (rootCounts != nullptr) {
+		rootCounts->assign(rootMoves.size(), 0);
+	}
+	if (depth <= 0) {
+		return 1;
+	}
+
+	// Split two plies down when there is depth left for it, one ply otherwise
+	std::vector<PerftTask> tasks;
+	for (int i = 0; i < rootMoves.size(); i++) {
+		brd.enactMove(rootMoves[i]);
+
+		if (depth >= 3) {
+			MoveList replies;
+			brd.getAllValidColorMoves(intToColorType(brd.getTurnNumber()), replies, false);
+			for (Move &reply : replies) {
+				brd.enactMove(reply);
+				tasks.push_back(PerftTask{ brd.getSnapshot(), i, depth - 2 });
+				brd.undoLastMove();
+			}
+		} else {
+			tasks.push_back(PerftTask{ brd.getSnapshot(), i, depth - 1 });
+		}
+
+		brd.undoLastMove();
+	}
+
+	std::vector<unsigned long long> taskNodes(tasks.size(), 0);
+	std::atomic<int> nextTask(0);
+
+	auto worker = [&tasks, &taskNodes, &nextTask, table]() {
+		Board board;
+		while (true) {
+			int index = nextTask.fetch_add(1);
+			if (index >= (int)tasks.size()) {
+				break;
+			}
+
+			board.loadSnapshot(tasks[index].snapshot);
+			taskNodes[index] = (table != nullptr) ? hashedPerft(board, tasks[index].depth, *table) : perft(board, tasks[index].depth);
+		}
+	};
+
+	// std::thread throws once the system runs out of threads, so never start more than there are tasks
+	// or a few per core. hardware_concurrency is 0 when it cannot be told
+	int cores = std::max((int)std::thread::hardware_concurrency(), 1);
+	int workerCount = std::min({ threads, (int)tasks.size(), cores * PERFT_THREADS_PER_CORE });
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < std::max(workerCount, 1); i++) {
+		workers.push_back(std::thread(worker));
+	}
+	for (std::thread &thread : workers) {
+		thread.join();
+	}
+
+	unsigned long long nodes = 0;
+	for (int i = 0; i < (int)tasks.size(); i++) {
+		nodes += taskNodes[i];
+		if (rootCounts != nullptr) {
+			(*rootCounts)[tasks[i].rootIndex] += taskNodes[i];
+		}
+	}
+
+	return nodes;
+}
+
+static std::string squareName(std::pair<int, int> position) {
+	std::string name;
+	name += (char)('a' + position.first);
+	name += (char)('8' - position.second);
+	return name;
+}
+
+std::string moveName(Move &mv) {
+	// A castling move's destination is the rook's tile, the king lands on the capture tile
+	MoveType mt = mv.getMoveType();
+	bool isCastling = (mt == MoveType::CASTLE_KING || mt == MoveType::CASTLE_QUEEN);
+
+	std::string name = squareName(mv.getFromPosition());
+	name += squareName(isCastling ? mv.getCapturePosition() : mv.getDestinationPosition());
+
+	if (mt == MoveType::PROMOTE) {
+		char promotion = charFromPiece(makePieceCode(mv.getPromoteType(), ColorType::BLACK));
+		name += promotion;
+	}
+
+	return name;
+}
+
+static void printSpeed(unsigned long long nodes, double seconds) {
+	std::cout << "Nodes: " << nodes << std::endl;
+	std::cout << "Time: " << seconds << " s" << std::endl;
+	std::cout << "Nodes/sec: " << (unsigned long long)(seconds > 0 ? nodes / seconds : 0) << std::endl;
+}
+
+static void printTableStats(PerftTable &table) {
+	unsigned long long probes = table.getProbes();
+	double hitRate = (probes > 0) ? (double)table.getHits() / probes : 0;
+
+	std::cout << "Hash entries: " << table.size() << std::endl;
+	std::cout << "Hash hits: " << table.getHits() << " of " << probes << " probes (" << hitRate * 100 << "%)" << std::endl;
+	std::cout << "Hash occupancy: " << table.occupancy() * 100 << "%" << std::endl;
+}
+
+// The count below the position on the caller's thread, hashed when there is a table
+static unsigned long long countNodes(Board &brd, int depth, PerftTable *table) {
+	return (table != nullptr) ? hashedPerft(brd, depth, *table) : perft(brd, depth);
+}
+
+void printPerft(Board &brd, int depth, int threads, size_t hashMegabytes) {
+	// The table is allocated and cleared before the clock starts
+	std::unique_ptr<PerftTable> table;
+	if (hashMegabytes > 0) {
+		table.reset(new PerftTable(hashMegabytes));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	unsigned long long nodes = (threads > 1) ? parallelPerft(brd, depth, threads, nullptr, table.get()) : countNodes(brd, depth, table.get());
+	auto end = std::chrono::steady_clock::now();
+
+	printSpeed(nodes, std::chrono::duration<double>(end - start).count());
+	if (table) {
+		printTableStats(*table);
+	}
+}
+
+void printDivide(Board &brd, int depth, int threads, size_t hashMegabytes) {
+	std::unique_ptr<PerftTable> table;
+	if (hashMegabytes > 0) {
+		table.reset(new PerftTable(hashMegabytes));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	MoveList moves;
+	brd.getAllValidColorMoves(intToColorType(brd.getTurnNumber()), moves, false);
+
+	std::vector<unsigned long long> rootCounts;
+	if (threads > 1) {
+		parallelPerft(brd, depth, threads, &rootCounts, table.get());
+	} else {
+		for (Move &mv : moves) {
+			brd.enactMove(mv);
+			rootCounts.push_back(countNodes(brd, depth - 1, table.get()));
+			brd.undoLastMove();
+		}
+	}
+
+	unsigned long long nodes = 0;
+	for (int i = 0; i < moves.size(); i++) {
+		std::cout << moveName(moves[i]) << ": " << rootCounts[i] << std::endl;
+		nodes += rootCounts[i];
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	std::cout << std::endl;
+	printSpeed(nodes, std::chrono::duration<double>(end - start).count());
+	if (table) {
+		printTableStats(*table);
+	}
+}
@@ -0,0 +1,86 @@
+#ifndef _HEADER_PERFT_H_
+#define _HEADER_PERFT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+
+class Board;
+class Move;
+
+// Counts the leaf nodes of the legal move tree below the position, for the side whose turn it is
+// This is the standard test of a move generator, the counts are published for well known positions
+// With bulk counting the last ply counts the generated moves instead of enacting each of them
+unsigned long long perft(Board &brd, int depth, bool bulkCounting = true);
+
+// The largest table -hash MB can ask for, a perft table past a gigabyte buys nothing at the depths run here
+const size_t PERFT_MAX_HASH_MEGABYTES = 1024;
+
+// A fixed size table of subtree counts keyed by the Zobrist key of a position and the depth below it,
+// shared by every worker of a hashed perft so a subtree reached by another move order is counted once
+// Entries are read and written without locks. Each holds the data and the key xored with the data, an entry
+// torn by two threads writing at once no longer xors back to its key and reads as a miss
+class PerftTable {
+	struct Entry {
+		std::atomic<unsigned long long> check;
+		// The node count above the low 8 bits, the depth in them
+		std::atomic<unsigned long long> data;
+	};
+
+	std::unique_ptr<Entry[]> entries;
+	size_t entryCount;
+
+	std::atomic<unsigned long long> probes;
+	std::atomic<unsigned long long> hits;
+
+	public:
+		// The entry count is the largest power of two that fits in megabytes, at least one
+		// megabytes is capped at PERFT_MAX_HASH_MEGABYTES, and the count is halved until the allocation succeeds
+		explicit PerftTable(size_t megabytes);
+
+		// False on a miss, otherwise nodes is the count stored for the position at this depth
+		bool probe(ZobristKey key, int depth, unsigned long long &nodes) const;
+		// Always replaces what was in the entry
+		void store(ZobristKey key, int depth, unsigned long long nodes);
+		void clear();
+
+		// Each search adds up its own probes and hits and reports them once at the end
+		void addStats(unsigned long long searchProbes, unsigned long long searchHits);
+		unsigned long long getProbes() const;
+		unsigned long long getHits() const;
+		// The share of entries holding a count, from 0 to 1
+		double occupancy() const;
+		size_t size() const;
+};
+
+// perft with the counts of subtrees two or more plies deep looked up in and saved to table
+unsigned long long hashedPerft(Board &brd, int depth, PerftTable &table);
+
+// The same count on threads workers, each loading its own copy of the position from a BoardSnapshot
+// The subtrees two plies below the root are queued and each worker takes the next one when it is free,
+// so a root move with a big subtree does not leave the others waiting. The total always matches perft()
+// rootCounts, when given, receives the nodes below each legal root move in the order they are generated
+// With a table the workers run hashedPerft and share it
+// threads is capped at the number of subtrees and at PERFT_THREADS_PER_CORE per core
+const int PERFT_THREADS_PER_CORE = 4;
+unsigned long long parallelPerft(Board &brd, int depth, int threads, std::vector<unsigned long long> *rootCounts = nullptr, PerftTable *table = nullptr);
+
+// The move in coordinate notation, such as e2e4, e7e8q or e1g1 for castling
+std::string moveName(Move &mv);
+
+// Run perft and print the nodes, the elapsed time and the nodes per second
+// divide also prints the nodes below each legal move first, comparing them against another engine
+// shows which move a wrong count comes from
+// A hashMegabytes above 0 counts with a PerftTable of that size and prints its hit rate and occupancy
+void printPerft(Board &brd, int depth, int threads = 1, size_t hashMegabytes = 0);
+void printDivide(Board &brd, int depth, int threads = 1, size_t hashMegabytes = 0);
+
+#endif // !_HEADER_PERFT_H_
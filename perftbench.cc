@@ -0,0 +1,273 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "board.h"
+#include "magic.h"
+#include "perft.h"
+#include "movepicker.h"
+
+// Runs perft on positions with published node counts and reports the speed of move generation
+// and make/unmake in nodes per second, once for every slider backend this CPU can run
+// "perftbench -threads N" counts with parallelPerft on N workers instead
+// "perftbench -hash MB" counts with a PerftTable of that size, cleared before each position
+// Before timing anything it checks that MovePicker hands out exactly the legal moves in every position
+// a few plies into each tree and that a set up position with more moves than a game can have is counted
+
+struct PerftPosition {
+	const char *name;
+	char tiles[8][8];
+	int turnNumber;
+	int depth;
+	unsigned long long expectedNodes;
+};
+
+PerftPosition positions[] = {
+	{ "start", {
+		{'r','n','b','q','k','b','n','r'},
+		{'p','p','p','p','p','p','p','p'},
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','_','_','_','_','_','_'},
+		{'P','P','P','P','P','P','P','P'},
+		{'R','N','B','Q','K','B','N','R'} }, 0, 6, 119060324ULL },
+	{ "kiwipete", {
+		{'r','_','_','_','k','_','_','r'},
+		{'p','_','p','p','q','p','b','_'},
+		{'b','n','_','_','p','n','p','_'},
+		{'_','_','_','P','N','_','_','_'},
+		{'_','p','_','_','P','_','_','_'},
+		{'_','_','N','_','_','Q','_','p'},
+		{'P','P','P','B','B','P','P','P'},
+		{'R','_','_','_','K','_','_','R'} }, 0, 5, 193690690ULL },
+	{ "endgame", {
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','p','_','_','_','_','_'},
+		{'_','_','_','p','_','_','_','_'},
+		{'K','P','_','_','_','_','_','r'},
+		{'_','R','_','_','_','p','_','k'},
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','_','_','P','_','P','_'},
+		{'_','_','_','_','_','_','_','_'} }, 0, 6, 11030083ULL },
+	{ "promotions", {
+		{'r','_','_','_','k','_','_','r'},
+		{'P','p','p','p','_','p','p','p'},
+		{'_','b','_','_','_','n','b','N'},
+		{'n','P','_','_','_','_','_','_'},
+		{'B','B','P','_','P','_','_','_'},
+		{'q','_','_','_','_','N','_','_'},
+		{'P','p','_','P','_','_','P','P'},
+		{'R','_','_','Q','_','R','K','_'} }, 0, 5, 15833292ULL },
+	{ "middlegame", {
+		{'r','n','b','q','_','k','_','r'},
+		{'p','p','_','P','b','p','p','p'},
+		{'_','_','p','_','_','_','_','_'},
+		{'_','_','_','_','_','_','_','_'},
+		{'_','_','B','_','_','_','_','_'},
+		{'_','_','_','_','_','_','_','_'},
+		{'P','P','P','_','N','n','P','P'},
+		{'R','N','B','Q','K','_','_','R'} }, 0, 4, 2103487ULL },
+};
+
+const int PICKER_CHECK_DEPTH = 3;
+
+// Whether the picker hands out every legal move exactly once and nothing else
+bool pickerMatches(Board &board, const Move *hashMove, const Move *killers, int killerCount) {
+	ColorType ct = intToColorType(board.getTurnNumber());
+
+	MoveList legalMoves;
+	board.getValidColorMoves(ct, legalMoves, MoveGenType::ALL);
+
+	MovePicker picker(board, ct, hashMove, killers, killerCount);
+	MoveList picked;
+	Move mv;
+	while (picker.next(mv)) {
+		if (picked.size() == legalMoves.size()) {
+			return false;
+		}
+		picked.push_back(mv);
+	}
+
+	if (picked.size() != legalMoves.size()) {
+		return false;
+	}
+	for (Move &legal : legalMoves) {
+		if (std::count(picked.begin(), picked.end(), legal) != 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Walks the tree to depth and runs the picker at every node, the hash move and the killers are moves of the
+// node visited before, so some are legal here and some are not. recent holds those moves between calls
+bool checkMovePicker(Board &board, int depth, MoveList &recent, unsigned long long &positions) {
+	const Move *hashMove = (recent.size() > 0) ? &recent[0] : nullptr;
+	const Move *killers = (recent.size() > 1) ? &recent[1] : nullptr;
+	int killerCount = (recent.size() > 1) ? std::min(recent.size() - 1, 2) : 0;
+
+	if (!pickerMatches(board, hashMove, killers, killerCount)) {
+		return false;
+	}
+	positions++;
+
+	MoveList moves;
+	board.getValidColorMoves(intToColorType(board.getTurnNumber()), moves, MoveGenType::ALL);
+
+	// The last moves generated are mostly quiet ones, the kind killers are
+	recent.clear();
+	for (int i = moves.size() - 1; i >= 0 && recent.size() < 3; i--) {
+		recent.push_back(moves[i]);
+	}
+
+	if (depth <= 1) {
+		return true;
+	}
+
+	for (Move &mv : moves) {
+		board.enactMove(mv);
+		bool matches = checkMovePicker(board, depth - 1, recent, positions);
+		board.undoLastMove();
+
+		if (!matches) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// A position set up mode accepts with more legal moves than the 218 a game can reach, 265 for the queens
+// and the pawn counted ray by ray and one king move. Generating them used to overflow the MoveList
+PerftPosition crowded = { "crowded", {
+	{'Q','Q','Q','Q','Q','Q','b','k'},
+	{'Q','_','_','_','_','Q','_','P'},
+	{'Q','_','_','_','_','_','Q','Q'},
+	{'Q','_','_','_','_','_','_','Q'},
+	{'Q','_','_','_','_','_','_','Q'},
+	{'Q','_','_','_','_','_','_','Q'},
+	{'Q','_','_','_','_','_','_','Q'},
+	{'K','Q','Q','Q','Q','Q','Q','Q'} }, 0, 1, 266ULL };
+
+// Returns false if the crowded position is rejected or its moves are miscounted
+bool checkCrowded() {
+	Board board(crowded.tiles);
+	board.setTurnNumber(crowded.turnNumber);
+
+	bool valid = board.validate();
+	MoveList legalMoves;
+	GameState state = board.gameState(legalMoves);
+	unsigned long long nodes = perft(board, crowded.depth, false);
+
+	MoveList recent;
+	unsigned long long checked = 0;
+	bool matches = valid && state == GameState::ONGOING && nodes == crowded.expectedNodes && legalMoves.size() == (int)nodes
+		&& checkMovePicker(board, 2, recent, checked);
+
+	std::cout << crowded.name << ": " << nodes << " moves of at most " << MAX_MOVES << (matches ? "" : " (MISMATCH)") << std::endl;
+	return matches;
+}
+
+// Returns false if the picker differs from the legal moves in any position checked
+bool checkPositions() {
+	bool allMatch = true;
+	for (PerftPosition &position : positions) {
+		Board board(position.tiles);
+		board.setTurnNumber(position.turnNumber);
+
+		MoveList recent;
+		unsigned long long checked = 0;
+		bool matches = checkMovePicker(board, PICKER_CHECK_DEPTH, recent, checked);
+
+		std::cout << position.name << " move picker: " << checked << " positions" << (matches ? "" : " (MISMATCH)") << std::endl;
+		allMatch = allMatch && matches;
+	}
+	return allMatch;
+}
+
+// Returns false if a node count does not match the published one
+bool runPositions(int threads, PerftTable *table) {
+	unsigned long long totalNodes = 0;
+	double totalSeconds = 0;
+	bool allMatch = true;
+
+	for (PerftPosition &position : positions) {
+		Board board(position.tiles);
+		board.setTurnNumber(position.turnNumber);
+
+		if (table != nullptr) {
+			table->clear();
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		unsigned long long nodes;
+		if (threads > 1) {
+			nodes = parallelPerft(board, position.depth, threads, nullptr, table);
+		} else {
+			nodes = (table != nullptr) ? hashedPerft(board, position.depth, *table) : perft(board, position.depth);
+		}
+		auto end = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(end - start).count();
+
+		totalNodes += nodes;
+		totalSeconds += seconds;
+
+		std::cout << position.name << " depth " << position.depth << ": " << nodes << " nodes, " << seconds << " s, "
+			<< (unsigned long long)(nodes / seconds) << " nps";
+		if (nodes != position.expectedNodes) {
+			std::cout << " (EXPECTED " << position.expectedNodes << ")";
+			allMatch = false;
+		}
+		if (table != nullptr) {
+			std::cout << ", " << (unsigned long long)(100.0 * table->getHits() / std::max(table->getProbes(), 1ULL)) << "% hits, "
+				<< (unsigned long long)(100 * table->occupancy()) << "% occupied";
+		}
+		std::cout << std::endl;
+	}
+
+	std::cout << "total: " << totalNodes << " nodes, " << totalSeconds << " s, " << (unsigned long long)(totalNodes / totalSeconds) << " nps" << std::endl;
+
+	return allMatch;
+}
+
+int main(int argc, char *argv[]) {
+	int threads = 1;
+	int hashMegabytes = 0;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "-threads") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) >= 1) {
+			threads = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "-hash") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) >= 1) {
+			hashMegabytes = std::atoi(argv[++i]);
+		} else {
+			std::cout << "usage: perftbench [-threads N] [-hash MB]" << std::endl;
+			return 2;
+		}
+	}
+
+	initMagics();
+	SliderBackend picked = sliderBackend;
+	std::cout << "startup picked the " << sliderBackendName(picked) << " slider backend" << std::endl;
+	std::cout << threads << ((threads == 1) ? " thread" : " threads") << ", " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+	std::unique_ptr<PerftTable> table;
+	if (hashMegabytes > 0) {
+		table.reset(new PerftTable(hashMegabytes));
+		std::cout << "hash table of " << table->size() << " entries" << std::endl;
+	}
+
+	bool allMatch = checkPositions();
+	allMatch = checkCrowded() && allMatch;
+
+	for (SliderBackend backend : { SliderBackend::MAGIC, SliderBackend::PEXT }) {
+		if (!setSliderBackend(backend)) {
+			std::cout << std::endl << sliderBackendName(backend) << ": not supported on this CPU" << std::endl;
+			continue;
+		}
+
+		std::cout << std::endl << sliderBackendName(backend) << ":" << std::endl;
+		allMatch = runPositions(threads, table.get()) && allMatch;
+	}
+
+	return allMatch ? 0 : 1;
+}
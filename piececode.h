@@ -0,0 +1,32 @@
+#ifndef _HEADER_PIECECODE_H_
+#define _HEADER_PIECECODE_H_
+
+enum class PieceType { PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING, EMPTY_TILE };
+enum class ColorType { WHITE, BLACK, NONE };
+
+// A PieceCode is the value stored on every square of the board
+// Bits 0-2 hold the PieceType and bit 3 is set for black pieces
+typedef unsigned char PieceCode;
+
+const PieceCode EMPTY_CODE = (PieceCode)PieceType::EMPTY_TILE;
+
+// Packs a type and color into a PieceCode, anything without a color is empty
+inline PieceCode makePieceCode(PieceType pType, ColorType cType) {
+	if (pType == PieceType::EMPTY_TILE || cType == ColorType::NONE) {
+		return EMPTY_CODE;
+	}
+	return (PieceCode)((int)pType | ((int)cType << 3));
+}
+
+inline PieceType pieceTypeOf(PieceCode pc) {
+	return (PieceType)(pc & 7);
+}
+
+inline ColorType colorOf(PieceCode pc) {
+	if (pc == EMPTY_CODE) {
+		return ColorType::NONE;
+	}
+	return (ColorType)(pc >> 3);
+}
+
+#endif // !_HEADER_PIECECODE_H_
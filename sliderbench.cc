@@ -0,0 +1,167 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "bitboard.h"
+#include "magic.h"
+#include "koggestone.h"
+
+// Compares the magic and PEXT slider lookups against walking each ray tile by tile
+// All are run on the same random occupancies, the checksums must match
+// Then compares whole attack maps of both colors built from magic lookups against the Kogge-Stone fills
+
+typedef Bitboard (*SliderFunction)(int, Bitboard);
+
+// The sliders of one position, index by color
+struct SliderPosition {
+	Bitboard diagonalSliders[2];
+	Bitboard straightSliders[2];
+	Bitboard occupied;
+};
+
+double timeSlider(SliderFunction slider, const std::vector<Bitboard> &occupancies, Bitboard &checksum) {
+	auto start = std::chrono::steady_clock::now();
+
+	for (Bitboard occupied : occupancies) {
+		for (int square = 0; square < 64; square++) {
+			checksum ^= slider(square, occupied);
+		}
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+	return nanoseconds / (occupancies.size() * 64.0);
+}
+
+// Attack maps from one magic lookup per slider, as Board::getColorAttacks used to build them
+void magicAttackMaps(const Bitboard diagonalSliders[2], const Bitboard straightSliders[2], Bitboard occupied, Bitboard attacks[2]) {
+	for (int color = 0; color < 2; color++) {
+		attacks[color] = EMPTY_BB;
+
+		Bitboard diagonal = diagonalSliders[color];
+		while (diagonal) {
+			attacks[color] |= bishopAttacks<SliderBackend::MAGIC>(popLsb(diagonal), occupied);
+		}
+		Bitboard straight = straightSliders[color];
+		while (straight) {
+			attacks[color] |= rookAttacks<SliderBackend::MAGIC>(popLsb(straight), occupied);
+		}
+	}
+}
+
+double timeAttackMaps(SlidingAttackMapsFunction attackMaps, const std::vector<SliderPosition> &positions, Bitboard &checksum) {
+	auto start = std::chrono::steady_clock::now();
+
+	for (const SliderPosition &position : positions) {
+		Bitboard attacks[2];
+		attackMaps(position.diagonalSliders, position.straightSliders, position.occupied, attacks);
+		checksum ^= attacks[0] * 3 + attacks[1];
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+	return nanoseconds / positions.size();
+}
+
+int main() {
+	initMagics();
+
+	// Boards with roughly a quarter of the tiles occupied
+	std::vector<Bitboard> occupancies;
+	Bitboard state = 0x9E3779B97F4A7C15ULL;
+	for (int i = 0; i < 200000; i++) {
+		Bitboard occupied = ~EMPTY_BB;
+		for (int j = 0; j < 2; j++) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			occupied &= state;
+		}
+		occupancies.push_back(occupied);
+	}
+
+	const char *names[2] = { "bishop", "rook" };
+	SliderFunction rayFunctions[2] = { bishopRayAttacks, rookRayAttacks };
+	SliderFunction magicFunctions[2] = { bishopAttacks<SliderBackend::MAGIC>, rookAttacks<SliderBackend::MAGIC> };
+	SliderFunction pextFunctions[2] = { bishopAttacks<SliderBackend::PEXT>, rookAttacks<SliderBackend::PEXT> };
+
+	for (int i = 0; i < 2; i++) {
+		Bitboard rayChecksum = 0;
+		Bitboard magicChecksum = 0;
+
+		double rayTime = timeSlider(rayFunctions[i], occupancies, rayChecksum);
+		setSliderBackend(SliderBackend::MAGIC);
+		double magicTime = timeSlider(magicFunctions[i], occupancies, magicChecksum);
+
+		std::cout << names[i] << ": ray walk " << rayTime << " ns, magic " << magicTime << " ns, speedup " << rayTime / magicTime << "x";
+		if (rayChecksum != magicChecksum) {
+			std::cout << " (CHECKSUM MISMATCH)";
+		}
+
+		// The same lookups with the tables laid out for PEXT
+		if (setSliderBackend(SliderBackend::PEXT)) {
+			Bitboard pextChecksum = 0;
+			double pextTime = timeSlider(pextFunctions[i], occupancies, pextChecksum);
+
+			std::cout << ", pext " << pextTime << " ns";
+			if (rayChecksum != pextChecksum) {
+				std::cout << " (CHECKSUM MISMATCH)";
+			}
+		}
+		std::cout << std::endl;
+	}
+	setSliderBackend(SliderBackend::MAGIC);
+
+	// Each color gets a queen, two rooks and two bishops on random occupied tiles, the usual middlegame count
+	std::vector<SliderPosition> positions;
+	for (Bitboard occupied : occupancies) {
+		SliderPosition position = {};
+		position.occupied = occupied;
+
+		Bitboard pieces = occupied;
+		for (int color = 0; color < 2; color++) {
+			for (int piece = 0; piece < 5 && pieces; piece++) {
+				Bitboard bb = squareBB(popLsb(pieces));
+				if (piece != 1 && piece != 2) {
+					position.diagonalSliders[color] |= bb;
+				}
+				if (piece != 3 && piece != 4) {
+					position.straightSliders[color] |= bb;
+				}
+				// Skip a few tiles so the two colors do not sit next to each other
+				for (int skip = 0; skip < 2 && pieces; skip++) {
+					popLsb(pieces);
+				}
+			}
+		}
+		positions.push_back(position);
+	}
+
+	const char *mapNames[4] = { "magic", "kogge-stone scalar", "kogge-stone sse2", "kogge-stone avx2" };
+	SlidingAttackMapsFunction mapFunctions[4] = { magicAttackMaps, slidingAttackMapsScalar, slidingAttackMapsSse2, slidingAttackMapsAvx2 };
+	Bitboard magicChecksum = 0;
+
+	std::cout << "attack maps of both colors:" << std::endl;
+	for (int i = 0; i < 4; i++) {
+		if (mapFunctions[i] == nullptr || (mapFunctions[i] == slidingAttackMapsAvx2 && !hasAvx2())) {
+			std::cout << "  " << mapNames[i] << ": not supported on this CPU" << std::endl;
+			continue;
+		}
+
+		Bitboard checksum = 0;
+		double time = timeAttackMaps(mapFunctions[i], positions, checksum);
+		if (i == 0) {
+			magicChecksum = checksum;
+		}
+
+		std::cout << "  " << mapNames[i] << ": " << time << " ns";
+		if (checksum != magicChecksum) {
+			std::cout << " (CHECKSUM MISMATCH)";
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
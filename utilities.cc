@@ -1,6 +1,6 @@
 #include "utilities.h"
 
-std::shared_ptr<Piece> pieceConstructor(char pieceCharacter, int x, int y) {
+PieceCode pieceCodeFromChar(char pieceCharacter) {
 	
 	if (pieceCharacter == '_') {
 		// empty character has color of ColorType::NONE
@@ -13,42 +13,42 @@ std::shared_ptr<Piece> pieceConstructor(char pieceCharacter, int x, int y) {
 		pieceCharacter = pieceCharacter - 'A' + 'a';
 	}
 
-	std::shared_ptr<Piece> sharedPiece;
+	PieceType pType = PieceType::EMPTY_TILE;
 
 	// Convert lowercase char to piece
 	switch (pieceCharacter) {
 		case 'p':
-			sharedPiece = std::make_shared<Pawn>(Pawn(cType, x, y));
+			pType = PieceType::PAWN;
 			break;
 		case 'n':
-			sharedPiece =  std::make_shared<Knight>(Knight(cType, x, y));
+			pType = PieceType::KNIGHT;
 			break;
 		case 'b':
-			sharedPiece = std::make_shared<Bishop>(Bishop(cType, x, y));
+			pType = PieceType::BISHOP;
 			break;
 		case 'r':
-			sharedPiece = std::make_shared<Rook>(Rook(cType, x, y));
+			pType = PieceType::ROOK;
 			break;
 		case 'q':
-			sharedPiece = std::make_shared<Queen>(Queen(cType, x, y));
+			pType = PieceType::QUEEN;
 			break;
 		case 'k':
-			sharedPiece = std::make_shared<King>(King(cType, x, y));
+			pType = PieceType::KING;
 			break;
 		case '_':
-			sharedPiece = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, x, y));
+			pType = PieceType::EMPTY_TILE;
 			break;
 		default:
-			sharedPiece = std::make_shared<EmptyTile>(EmptyTile(ColorType::NONE, x, y));
+			pType = PieceType::EMPTY_TILE;
 			break;
 	}
 
-	return sharedPiece;
+	return makePieceCode(pType, cType);
 }
 
-char charFromPiece(std::shared_ptr<Piece> pc) {
-	PieceType pType = pc->getPieceType();
-	ColorType cType = pc->getColorType();
+char charFromPiece(PieceCode pc) {
+	PieceType pType = pieceTypeOf(pc);
+	ColorType cType = colorOf(pc);
 
 	char pChar = '_';
 
@@ -1,19 +1,13 @@
 #ifndef _HEADER_UTILITIES_H_
 #define _HEADER_UTILITIES_H_
 
-#include <memory>
+#include "piececode.h"
 
-#include "piece.h"
+// Creates a PieceCode based on the character
+PieceCode pieceCodeFromChar(char pieceCharacter);
 
-enum class PieceType;
-enum class ColorType;
-class Piece;
-
-// Creates a Piece based on the character and its location
-std::shared_ptr<Piece> pieceConstructor(char pieceCharacter, int x, int y);
-
-// Returns the char associated to that Piece
-char charFromPiece(std::shared_ptr<Piece> pc);
+// Returns the char associated to that PieceCode
+char charFromPiece(PieceCode pc);
 
 // Returns the opposite color
 // White -> Black
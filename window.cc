@@ -41,7 +41,7 @@ Xwindow::Xwindow(Board &board)
         colors[i] = xcolor.pixel;
     }
 
-    XSetForeground(d, gc, colors[Black]);
+    XSetForeground(dis, gc, colors[Black]);
 
     // Make window non-resizeable.
     XSizeHints hints;
@@ -60,9 +60,9 @@ Xwindow::Xwindow(Board &board)
     hints.max_width = frameWidth;
 
     // Set hints
-    XSetNormalHints(d, w, &hints);
+    XSetNormalHints(dis, w, &hints);
 
-    XSynchronize(d, True);
+    XSynchronize(dis, True);
 
     usleep(500);
 
@@ -71,9 +71,9 @@ Xwindow::Xwindow(Board &board)
     {
         for (int col = 0; col < 8; col++)
         {
-            std::shared_ptr<Piece> thePiece = board.getAt(col, row);
-            PieceType pType = thePiece->getPieceType();
-            ColorType cType = thePiece->getColorType();
+            PieceCode thePiece = board.getAt(col, row);
+            PieceType pType = pieceTypeOf(thePiece);
+            ColorType cType = colorOf(thePiece);
 
             std::pair<PieceType, ColorType> pieceColorPair = std::pair<PieceType, ColorType>(pType, cType);
             newBoard[row][col] = pieceColorPair;
@@ -365,9 +365,9 @@ void Xwindow::load(Board &board)
     {
         for (int col = 0; col < 8; col++)
         {
-            std::shared_ptr<Piece> thePiece = board.getAt(col, row);
-            PieceType pType = thePiece->getPieceType();
-            ColorType cType = thePiece->getColorType();
+            PieceCode thePiece = board.getAt(col, row);
+            PieceType pType = pieceTypeOf(thePiece);
+            ColorType cType = colorOf(thePiece);
 
             std::pair<PieceType, ColorType> pieceColorPair = std::pair<PieceType, ColorType>(pType, cType);
 
@@ -381,13 +381,13 @@ void Xwindow::load(Board &board)
 
 Xwindow::~Xwindow()
 {
-    XFreeGC(d, gc);
-    XCloseDisplay(d);
+    XFreeGC(dis, gc);
+    XCloseDisplay(dis);
 }
 
 void Xwindow::fillRectangle(int x, int y, int width, int height, int color)
 {
-    XSetForeground(d, gc, colors[color]);
-    XFillRectangle(d, w, gc, x, y, width, height);
-    XSetForeground(d, gc, colors[Black]);
+    XSetForeground(dis, gc, colors[color]);
+    XFillRectangle(dis, w, gc, x, y, width, height);
+    XSetForeground(dis, gc, colors[Black]);
 }
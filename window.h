@@ -5,7 +5,6 @@
 #include <string>
 
 #include "board.h"
-#include "piece.h"
 
 enum class ChessColor;
 enum class PieceType;
@@ -0,0 +1,54 @@
+#ifndef _HEADER_ZOBRIST_H_
+#define _HEADER_ZOBRIST_H_
+
+#include "piececode.h"
+
+// A position's Zobrist key is the xor of one random number per piece on its tile, one for the castling
+// rights, one for the en passant file and one when black is to move
+// The numbers come from a fixed seed so keys are the same from run to run
+typedef unsigned long long ZobristKey;
+
+struct ZobristKeys {
+	// Indexed by PieceCode then square, the codes of empty tiles are never used
+	ZobristKey pieces[16][64];
+	// Indexed by the castling rights bits
+	ZobristKey castling[16];
+	// Indexed by the column of the en passant square
+	ZobristKey enPassant[8];
+	ZobristKey blackToMove;
+};
+
+// splitmix64, a small generator that can run at compile time
+constexpr ZobristKey zobristRandom(ZobristKey &state) {
+	state += 0x9E3779B97F4A7C15ULL;
+	ZobristKey z = state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys() {
+	ZobristKeys keys = {};
+	ZobristKey state = 1070372;
+
+	for (int code = 0; code < 16; code++) {
+		for (int square = 0; square < 64; square++) {
+			keys.pieces[code][square] = zobristRandom(state);
+		}
+	}
+	for (int rights = 0; rights < 16; rights++) {
+		keys.castling[rights] = zobristRandom(state);
+	}
+	for (int column = 0; column < 8; column++) {
+		keys.enPassant[column] = zobristRandom(state);
+	}
+	keys.blackToMove = zobristRandom(state);
+
+	return keys;
+}
+
+constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+static_assert(ZOBRIST.blackToMove != 0, "zobrist keys must be built at compile time");
+
+#endif // !_HEADER_ZOBRIST_H_